@@ -6,6 +6,7 @@
 #include "legobuildingmanager.h"
 #include "legogamestate.h"
 #include "legoinputmanager.h"
+#include "legoinputrecorder.h"
 #include "legomain.h"
 #include "legomodelpresenter.h"
 #include "legopartpresenter.h"
@@ -16,9 +17,12 @@
 #include "mxbackgroundaudiomanager.h"
 #include "mxdirectx/mxdirect3d.h"
 #include "mxdsaction.h"
+#include "mxframepacer.h"
 #include "mxmisc.h"
 #include "mxomnicreateflags.h"
 #include "mxomnicreateparam.h"
+#include "mxsmkpresenter.h"
+#include "mxsoundmanager.h"
 #include "mxstreamer.h"
 #include "mxticklemanager.h"
 #include "mxtimer.h"
@@ -88,6 +92,10 @@ int g_targetDepth = 16;
 // GLOBAL: ISLE 0x410064
 BOOL g_reqEnableRMDevice = FALSE;
 
+// Not part of the original game.
+// Read by LoadConfig, applied once the input manager exists
+BOOL g_coalesceInputEvents = FALSE;
+
 // STRING: ISLE 0x4101c4
 #define WNDCLASS_NAME "Lego Island MainNoM App"
 
@@ -687,6 +695,10 @@ MxResult IsleApp::SetupWindow(HINSTANCE hInstance, LPSTR lpCmdLine)
 		if (LegoOmni::GetInstance()->GetInputManager()) {
 			LegoOmni::GetInstance()->GetInputManager()->SetUseJoystick(m_useJoystick);
 			LegoOmni::GetInstance()->GetInputManager()->SetJoystickIndex(m_joystickIndex);
+
+			if (g_coalesceInputEvents) {
+				LegoOmni::GetInstance()->GetInputManager()->SetEventMode(LegoInputManager::e_coalesced);
+			}
 		}
 	}
 	if (m_fullScreen) {
@@ -785,6 +797,8 @@ void IsleApp::LoadConfig()
 		strcpy(m_savePath, buffer);
 	}
 
+	BOOL decodeSmkInBackground = FALSE;
+
 	if (fs::exists(GetConfigFilePath()))
 	{
 		ini::IniFile IniFile;
@@ -818,6 +832,25 @@ void IsleApp::LoadConfig()
 		ReadEntry("UseJoystick", &m_useJoystick);
 		ReadEntry("JoystickIndex", &m_joystickIndex);
 		ReadEntry("DrawCursor", &m_drawCursor);
+		ReadEntry("DecodeSmackerInBackground", &decodeSmkInBackground);
+		ReadEntry("CoalesceInputEvents", &g_coalesceInputEvents);
+
+		std::string MixerOutput;
+		if (ReadEntry("MixerOutput", &MixerOutput))
+		{
+			MxSoundManager::SetMixerOutput(MixerOutput.c_str());
+		}
+
+		std::string InputLog;
+		if (ReadEntry("RecordInput", &InputLog))
+		{
+			LegoInputRecorder::SetLog(InputLog.c_str(), FALSE);
+		}
+
+		if (ReadEntry("PlayInput", &InputLog))
+		{
+			LegoInputRecorder::SetLog(InputLog.c_str(), TRUE);
+		}
 
 		int backBuffersInVRAM;
 		if (ReadEntry("WriteVideoRAM", &backBuffersInVRAM))
@@ -858,6 +891,20 @@ void IsleApp::LoadConfig()
 		ReadRegBool("UseJoystick", &m_useJoystick);
 		ReadRegInt("JoystickIndex", &m_joystickIndex);
 		ReadRegBool("Draw Cursor", &m_drawCursor);
+		ReadRegBool("Decode Smacker In Background", &decodeSmkInBackground);
+		ReadRegBool("Coalesce Input Events", &g_coalesceInputEvents);
+
+		if (ReadReg("Mixer Output", buffer, sizeof(buffer))) {
+			MxSoundManager::SetMixerOutput(buffer);
+		}
+
+		if (ReadReg("Record Input", buffer, sizeof(buffer))) {
+			LegoInputRecorder::SetLog(buffer, FALSE);
+		}
+
+		if (ReadReg("Play Input", buffer, sizeof(buffer))) {
+			LegoInputRecorder::SetLog(buffer, TRUE);
+		}
 
 		int backBuffersInVRAM;
 		if (ReadRegBool("Back Buffers in Video RAM", &backBuffersInVRAM)) {
@@ -889,8 +936,14 @@ void IsleApp::LoadConfig()
 			strcpy(m_deviceId, buffer);
 		}
 	}
+
+	MxSmkPresenter::SetDecodeInBackground(decodeSmkInBackground);
 }
 
+// Not part of the original game.
+// Replaces the millisecond frame gate of IsleApp::Tick.
+MxFramePacer g_framePacer;
+
 // FUNCTION: ISLE 0x402c20
 inline void IsleApp::Tick(BOOL sleepIfNotNextFrame)
 {
@@ -901,7 +954,11 @@ inline void IsleApp::Tick(BOOL sleepIfNotNextFrame)
 	static int g_startupDelay = 200;
 
 	if (!m_windowActive) {
-		Sleep(0);
+		// Nothing is drawn while inactive, wait for messages instead of spinning
+		if (sleepIfNotNextFrame != 0) {
+			MsgWaitForMultipleObjects(0, NULL, FALSE, m_frameDelta, QS_ALLINPUT);
+		}
+
 		return;
 	}
 
@@ -915,16 +972,17 @@ inline void IsleApp::Tick(BOOL sleepIfNotNextFrame)
 		return;
 	}
 
+	// The tickle manager works with the time last calculated by the timer
 	MxLong currentTime = Timer()->GetRealTime();
-	if (currentTime < g_lastFrameTime) {
-		g_lastFrameTime = -m_frameDelta;
-	}
+	g_framePacer.SetFrameDelta(m_frameDelta);
+
+	if (g_framePacer.IsFrameDue()) {
+		g_framePacer.BeginFrame();
+		g_lastFrameTime = currentTime;
 
-	if (m_frameDelta + g_lastFrameTime < currentTime) {
 		if (!Lego()->IsPaused()) {
 			TickleManager()->Tickle();
 		}
-		g_lastFrameTime = currentTime;
 
 		if (g_startupDelay == 0) {
 			return;
@@ -967,7 +1025,7 @@ inline void IsleApp::Tick(BOOL sleepIfNotNextFrame)
 		}
 	}
 	else if (sleepIfNotNextFrame != 0) {
-		Sleep(0);
+		g_framePacer.WaitForFrame(TRUE);
 	}
 }
 
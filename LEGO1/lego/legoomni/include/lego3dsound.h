@@ -24,6 +24,11 @@ class Lego3DSound {
 	void Reset();
 	MxS32 SetDistance(MxS32 p_min, MxS32 p_max);
 
+	// Not part of the original game. Used by Lego3DSoundUpdater.
+	LPDIRECTSOUND3DBUFFER GetDS3DBuffer() { return m_ds3dBuffer; }
+	LegoROI* GetPositionROI() { return m_positionROI; }
+	MxS32 GetVolume() { return m_volume; }
+
 	// SYNTHETIC: LEGO1 0x10011650
 	// Lego3DSound::`scalar deleting destructor'
 
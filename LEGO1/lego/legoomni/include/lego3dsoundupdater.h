@@ -0,0 +1,82 @@
+#ifndef LEGO3DSOUNDUPDATER_H
+#define LEGO3DSOUNDUPDATER_H
+
+#include "decomp.h"
+#include "mxtypes.h"
+
+#include <dsound.h>
+
+class Lego3DSound;
+
+// Updates all positioned 3D sounds in one pass per sound manager tick, instead
+// of every sound fetching the listener and talking to DirectSound on its own.
+// The pass snapshots the listener once, gathers the sound positions into arrays
+// and computes all distances and volumes in a single loop. A sound's result is
+// pushed to the driver when its owner updates it, and only when the position or
+// volume moved past a threshold since the last push.
+// Sounds that are added between two passes are evaluated on their first query.
+// Not part of the original game.
+// SIZE 0xb4c
+class Lego3DSoundUpdater {
+public:
+	enum {
+		c_maxSounds = 64,
+		c_volumeThreshold = 10 // hundredths of a decibel
+	};
+
+	enum Result {
+		e_notAdded = -1,
+		e_inaudible = 0,
+		e_audible = 1
+	};
+
+	Lego3DSoundUpdater();
+
+	static Lego3DSoundUpdater* GetInstance();
+
+	// Returns the share of a sound's volume that is audible at a squared distance
+	static float GetDistanceFactor(float p_distanceSquared);
+
+	MxResult Add(Lego3DSound* p_sound, LPDIRECTSOUNDBUFFER p_buffer);
+	void Remove(Lego3DSound* p_sound);
+	void Update();
+	Result GetResult(Lego3DSound* p_sound);
+	void Invalidate(Lego3DSound* p_sound);
+
+	MxU32 GetDriverCalls() { return m_driverCalls; }
+	MxU32 GetDriverCallsSaved() { return m_driverCallsSaved; }
+
+	void ResetStatistics()
+	{
+		m_driverCalls = 0;
+		m_driverCallsSaved = 0;
+	}
+
+private:
+	enum {
+		c_evaluated = 0x01,
+		c_audible = 0x02,
+		c_pushed = 0x04
+	};
+
+	void Evaluate(MxS32 p_begin, MxS32 p_end);
+	void Push(MxS32 p_index);
+
+	Lego3DSound* m_sounds[c_maxSounds];         // 0x000
+	LPDIRECTSOUNDBUFFER m_buffers[c_maxSounds]; // 0x100
+	float m_x[c_maxSounds];                     // 0x200
+	float m_y[c_maxSounds];                     // 0x300
+	float m_z[c_maxSounds];                     // 0x400
+	float m_distances[c_maxSounds];             // 0x500
+	MxS32 m_volumes[c_maxSounds];               // 0x600
+	float m_pushedX[c_maxSounds];               // 0x700
+	float m_pushedY[c_maxSounds];               // 0x800
+	float m_pushedZ[c_maxSounds];               // 0x900
+	MxS32 m_pushedVolumes[c_maxSounds];         // 0xa00
+	MxU8 m_states[c_maxSounds];                 // 0xb00
+	MxS32 m_numSounds;                          // 0xb40
+	MxU32 m_driverCalls;                        // 0xb44
+	MxU32 m_driverCallsSaved;                   // 0xb48
+};
+
+#endif // LEGO3DSOUNDUPDATER_H
@@ -29,10 +29,11 @@ class Lego3DWavePresenter : public MxWavePresenter {
 		return !strcmp(p_name, Lego3DWavePresenter::ClassName()) || MxWavePresenter::IsA(p_name);
 	}
 
-	void StartingTickle() override;   // vtable+0x1c
-	void StreamingTickle() override;  // vtable+0x20
-	MxResult AddToManager() override; // vtable+0x34
-	void Destroy() override;          // vtable+0x38
+	void StartingTickle() override;          // vtable+0x1c
+	void StreamingTickle() override;         // vtable+0x20
+	MxResult AddToManager() override;        // vtable+0x34
+	void Destroy() override;                 // vtable+0x38
+	void SetVolume(MxS32 p_volume) override; // vtable+0x60
 
 	// SYNTHETIC: LEGO1 0x1000f4b0
 	// Lego3DWavePresenter::`scalar deleting destructor'
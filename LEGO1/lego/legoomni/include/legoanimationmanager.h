@@ -257,6 +257,7 @@ class LegoAnimationManager : public MxCore {
 	);
 	void FUN_100648f0(LegoTranInfo* p_tranInfo, MxLong p_unk0x404);
 	void FUN_10064b50(MxLong p_time);
+	void ScheduleExtras(MxLong p_time);
 
 	LegoOmni::World m_worldId;          // 0x08
 	MxU16 m_animCount;                  // 0x0c
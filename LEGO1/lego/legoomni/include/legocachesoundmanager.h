@@ -14,13 +14,10 @@ struct LegoCacheSoundEntry {
 	LegoCacheSoundEntry(LegoCacheSound* p_sound, const char* p_name) : m_sound(p_sound), m_name(p_name) {}
 	LegoCacheSoundEntry(LegoCacheSound* p_sound) : m_sound(p_sound), m_name(p_sound->GetUnknown0x48().GetData()) {}
 
+	// Entries never own their name. It either belongs to the sound
+	// or, for lookups without a sound, to the caller.
 	// FUNCTION: LEGO1 0x1003d030
-	~LegoCacheSoundEntry()
-	{
-		if (m_sound == NULL && m_name != NULL) {
-			delete[] const_cast<char*>(m_name);
-		}
-	}
+	~LegoCacheSoundEntry() {}
 
 	bool operator==(LegoCacheSoundEntry) const { return 0; }
 	bool operator<(LegoCacheSoundEntry) const { return 0; }
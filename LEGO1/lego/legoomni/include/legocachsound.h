@@ -49,6 +49,9 @@ class LegoCacheSound : public MxCore {
 	void MuteSilence(MxBool p_muted);
 	void MuteStop(MxBool p_mute);
 
+	// Not part of the original game
+	static MxU32 GetSampleMemory() { return g_sampleMemory; }
+
 	// SYNTHETIC: LEGO1 0x10006610
 	// SYNTHETIC: BETA10 0x100675b0
 	// LegoCacheSound::`scalar deleting destructor'
@@ -56,6 +59,10 @@ class LegoCacheSound : public MxCore {
 private:
 	void Init();
 	void CopyData(MxU8* p_data, MxU32 p_dataSize);
+	void ShareData(MxU8* p_data, MxU32 p_dataSize);
+	void ReleaseData();
+	MxResult FillBuffer();
+	MxResult CreateDuplicate(LegoCacheSound* p_source);
 	MxString GetBaseFilename(MxString& p_path);
 
 	LPDIRECTSOUNDBUFFER m_dsBuffer; // 0x08
@@ -72,6 +79,9 @@ class LegoCacheSound : public MxCore {
 	MxBool m_unk0x70;               // 0x70
 	MxString m_unk0x74;             // 0x74
 	MxBool m_muted;                 // 0x84
+
+	// The bytes of sample data held by all sounds
+	static MxU32 g_sampleMemory;
 };
 
 #endif // LEGOCACHSOUND_H
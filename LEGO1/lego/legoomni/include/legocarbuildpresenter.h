@@ -4,6 +4,8 @@
 #include "anim/legoanim.h"
 #include "legoanimpresenter.h"
 
+struct LegoCarBuildIndex;
+
 // VTABLE: LEGO1 0x100d99e0
 // VTABLE: BETA10 0x101bb988
 // SIZE 0x150
@@ -62,6 +64,7 @@ class LegoCarBuildAnimPresenter : public LegoAnimPresenter {
 
 	void ReadyTickle() override;     // vtable+0x18
 	void StreamingTickle() override; // vtable+0x20
+	void Destroy() override;         // vtable+0x38
 	void EndAction() override;       // vtable+0x40
 	void PutFrame() override;        // vtable+0x6c
 
@@ -116,6 +119,13 @@ class LegoCarBuildAnimPresenter : public LegoAnimPresenter {
 private:
 	void Beta10Inline0x100733d0();
 
+	// Not part of the original game
+	LegoCarBuildIndex* GetIndex();
+	void BuildIndex();
+	void IndexNodes(LegoCarBuildIndex* p_index, LegoTreeNode* p_treeNode);
+	void IndexParts(LegoCarBuildIndex* p_index);
+	void DestroyIndex();
+
 	MxU16 m_unk0xbc; // 0xbc
 
 	// variable name verified by BETA10 0x1007184f
@@ -97,6 +97,7 @@ class LegoCharacterManager {
 private:
 	LegoROI* CreateActorROI(const char* p_key);
 	void RemoveROI(LegoROI* p_roi);
+	void UnshareLODList(LegoROI* p_roi);
 	LegoROI* FindChildROI(LegoROI* p_roi, const char* p_name);
 
 	static char* g_customizeAnimFile;
@@ -0,0 +1,113 @@
+#ifndef LEGOENTITYINDEX_H
+#define LEGOENTITYINDEX_H
+
+#include "mxtypes.h"
+
+#include <stddef.h>
+#include <string.h>
+
+class LegoEntity;
+
+// Maps entities to their index in the info table of the plant or building
+// manager, with open addressing in a table of fixed size. The managers keep it
+// current as entities are created and released. Since other code may change
+// the tables as well, a result has to be checked against the table, see
+// LegoPlantManager::GetInfo.
+// Not part of the original game.
+// SIZE 0x804
+class LegoEntityIndex {
+public:
+	enum {
+		c_numSlots = 256
+	};
+
+	LegoEntityIndex() { Clear(); }
+
+	void Clear()
+	{
+		memset(m_entities, 0, sizeof(m_entities));
+		m_count = 0;
+	}
+
+	void Set(LegoEntity* p_entity, MxS32 p_index)
+	{
+		if (p_entity == NULL) {
+			return;
+		}
+
+		MxS32 freeSlot = -1;
+		MxU32 slot = Hash(p_entity);
+
+		for (MxS32 i = 0; i < c_numSlots; i++, slot = (slot + 1) & (c_numSlots - 1)) {
+			if (m_entities[slot] == p_entity) {
+				m_indices[slot] = p_index;
+				return;
+			}
+
+			if (m_entities[slot] == Deleted() && freeSlot < 0) {
+				freeSlot = slot;
+			}
+			else if (m_entities[slot] == NULL) {
+				if (freeSlot < 0) {
+					freeSlot = slot;
+				}
+
+				break;
+			}
+		}
+
+		if (freeSlot >= 0) {
+			m_entities[freeSlot] = p_entity;
+			m_indices[freeSlot] = p_index;
+			m_count++;
+		}
+	}
+
+	void Remove(LegoEntity* p_entity)
+	{
+		MxS32 slot = FindSlot(p_entity);
+
+		if (slot >= 0) {
+			m_entities[slot] = Deleted();
+
+			// Without entries, the deleted markers can go as well
+			if (--m_count == 0) {
+				Clear();
+			}
+		}
+	}
+
+	// Returns -1 if the entity is not indexed
+	MxS32 Find(LegoEntity* p_entity) const
+	{
+		MxS32 slot = FindSlot(p_entity);
+		return slot >= 0 ? m_indices[slot] : -1;
+	}
+
+private:
+	static LegoEntity* Deleted() { return (LegoEntity*) 1; }
+	static MxU32 Hash(LegoEntity* p_entity) { return ((MxU32) (size_t) p_entity >> 4) & (c_numSlots - 1); }
+
+	MxS32 FindSlot(LegoEntity* p_entity) const
+	{
+		if (p_entity == NULL) {
+			return -1;
+		}
+
+		MxU32 slot = Hash(p_entity);
+
+		for (MxS32 i = 0; i < c_numSlots && m_entities[slot] != NULL; i++, slot = (slot + 1) & (c_numSlots - 1)) {
+			if (m_entities[slot] == p_entity) {
+				return slot;
+			}
+		}
+
+		return -1;
+	}
+
+	LegoEntity* m_entities[c_numSlots]; // 0x000
+	MxS32 m_indices[c_numSlots];        // 0x400
+	MxS32 m_count;                      // 0x800
+};
+
+#endif // LEGOENTITYINDEX_H
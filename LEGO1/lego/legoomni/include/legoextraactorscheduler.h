@@ -0,0 +1,95 @@
+#ifndef LEGOEXTRAACTORSCHEDULER_H
+#define LEGOEXTRAACTORSCHEDULER_H
+
+#include "decomp.h"
+#include "mxdirectx/mxstopwatch.h"
+#include "mxtypes.h"
+
+class LegoPathActor;
+class LegoROI;
+
+// Decides how often the extra actors spawned by the animation manager are
+// animated. Every few ticks the animation manager hands over its extras, which
+// are put into tiers by their distance to the point of view and whether they
+// are in the view frustum. Near actors are animated on every tick, mid and far
+// actors only after their tier's interval has passed. Since an actor catches up
+// from the time of its last update, a skipped tick only makes its steps larger.
+// The crowd budget limits how many actors are near at a time, the closest ones
+// win. Only near actors check for collisions with other actors; a collision
+// with a near actor is still found by the near actor itself.
+// Actors that are not classified, such as the user actor, are always animated.
+// Not part of the original game.
+// SIZE 0x2d0
+class LegoExtraActorScheduler {
+public:
+	enum Tier {
+		e_near = 0,
+		e_mid,
+		e_far,
+		e_numTiers
+	};
+
+	enum {
+		c_maxActors = 40,
+		c_classifyInterval = 250,
+		c_staleTime = 1000
+	};
+
+	LegoExtraActorScheduler();
+
+	static LegoExtraActorScheduler* GetInstance();
+
+	MxBool IsClassifyDue(MxLong p_time) { return p_time - m_classifyTime >= c_classifyInterval || p_time < m_classifyTime; }
+
+	void BeginClassify(MxLong p_time);
+	void Classify(LegoPathActor* p_actor, LegoROI* p_roi);
+	void EndClassify();
+
+	void Animate(LegoPathActor* p_actor, float p_time);
+	MxBool HasFullCollision(LegoPathActor* p_actor);
+
+	void SetCrowdBudget(MxS32 p_crowdBudget) { m_crowdBudget = p_crowdBudget; }
+	void SetDistances(float p_near, float p_far)
+	{
+		m_nearDistance = p_near;
+		m_farDistance = p_far;
+	}
+	void SetInterval(Tier p_tier, MxLong p_interval) { m_intervals[p_tier] = p_interval; }
+
+	MxS32 GetCrowdBudget() { return m_crowdBudget; }
+	MxS32 GetNumActors(Tier p_tier) { return m_numTierActors[p_tier]; }
+	MxU32 GetNumAnimated(Tier p_tier) { return m_numAnimated[p_tier]; }
+	MxU32 GetNumSkipped(Tier p_tier) { return m_numSkipped[p_tier]; }
+	double GetAnimateSeconds(Tier p_tier) { return m_timers[p_tier].ElapsedSeconds(); }
+
+	void ResetStatistics();
+
+private:
+	enum {
+		c_seen = 0x01,
+		c_inFrustum = 0x02
+	};
+
+	MxS32 Find(LegoPathActor* p_actor);
+	MxBool IsCurrent(float p_time) { return p_time - m_classifyTime <= c_staleTime && p_time >= m_classifyTime; }
+
+	MxStopWatch m_timers[e_numTiers];     // 0x000
+	LegoPathActor* m_actors[c_maxActors]; // 0x048
+	float m_distances[c_maxActors];       // 0x0e8
+	float m_nextTimes[c_maxActors];       // 0x188
+	MxU8 m_tiers[c_maxActors];            // 0x228
+	MxU8 m_flags[c_maxActors];            // 0x250
+	MxS32 m_numActors;                    // 0x278
+	MxLong m_classifyTime;                // 0x27c
+	float m_povPosition[3];               // 0x280
+	MxBool m_hasPov;                      // 0x28c
+	MxS32 m_crowdBudget;                  // 0x290
+	float m_nearDistance;                 // 0x294
+	float m_farDistance;                  // 0x298
+	MxLong m_intervals[e_numTiers];       // 0x29c
+	MxS32 m_numTierActors[e_numTiers];    // 0x2a8
+	MxU32 m_numAnimated[e_numTiers];      // 0x2b4
+	MxU32 m_numSkipped[e_numTiers];       // 0x2c0
+};
+
+#endif // LEGOEXTRAACTORSCHEDULER_H
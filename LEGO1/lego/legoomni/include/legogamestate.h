@@ -9,6 +9,7 @@
 #include <string.h>
 
 class LegoFile;
+class LegoSaveWriter;
 class LegoState;
 class LegoStorage;
 class MxVariableTable;
@@ -229,6 +230,8 @@ class LegoGameState {
 	void SetColors();
 	void SetROIHandlerFunction();
 
+	static LegoSaveWriter* g_saveWriter;
+
 	char* m_savePath;                           // 0x00
 	MxS16 m_stateCount;                         // 0x04
 	LegoState** m_stateArray;                   // 0x08
@@ -0,0 +1,46 @@
+#ifndef LEGOHITGRID_H
+#define LEGOHITGRID_H
+
+#include "mxpresenterlist.h"
+#include "mxstl/stlcompat.h"
+#include "mxtypes.h"
+
+class MxPresenter;
+
+// Buckets the screen rects of the hittable presenters in a presenter list into
+// a grid of square tiles, so a hit query only calls MxPresenter::IsHit on the
+// presenters that overlap the tile under the point. Each tile keeps its presenters
+// in the order LegoVideoManager::GetPresenterAt visits them, so the first hit is
+// the same presenter a full walk of the list would return.
+// The grid is rebuilt when MxVideoManager's layout version changes.
+// Not part of the original game.
+class LegoHitGrid {
+public:
+	enum {
+		c_tileShift = 5,
+		c_tileSize = 1 << c_tileShift,
+		c_columns = 640 / c_tileSize,
+		c_rows = 480 / c_tileSize,
+		c_numTiles = c_columns * c_rows
+	};
+
+	LegoHitGrid();
+
+	void Build(MxPresenterList* p_presenters, MxU32 p_version);
+	void Clear();
+	MxBool Find(MxS32 p_x, MxS32 p_y, MxPresenter*& p_presenter);
+
+	MxBool IsBuilt(MxPresenterList* p_presenters, MxU32 p_version) const
+	{
+		return m_presenters == p_presenters && m_version == p_version;
+	}
+
+private:
+	typedef vector<MxPresenter*> LegoHitGridTile;
+
+	MxPresenterList* m_presenters;       // 0x00
+	MxU32 m_version;                     // 0x04
+	LegoHitGridTile m_tiles[c_numTiles]; // 0x08
+};
+
+#endif // LEGOHITGRID_H
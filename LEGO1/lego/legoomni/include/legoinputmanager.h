@@ -27,7 +27,27 @@ extern const char* g_unk0x100f31b4;
 
 // VTABLE: LEGO1 0x100d8800
 // SIZE 0x18
-class LegoEventQueue : public MxQueue<LegoEventNotificationParam> {};
+class LegoEventQueue : public MxQueue<LegoEventNotificationParam> {
+public:
+	// If both p_param and the last queued event are mouse moves or drags with the
+	// same button state, the queued event is replaced by p_param and TRUE is returned.
+	// Drag samples from the window arrive as mouse moves with the button held.
+	MxBool MergeMotion(LegoEventNotificationParam& p_param)
+	{
+		if (this->m_last != NULL && IsMotion(p_param.GetNotification())) {
+			LegoEventNotificationParam last = this->m_last->GetValue();
+
+			if (last.GetNotification() == p_param.GetNotification() && last.GetModifier() == p_param.GetModifier()) {
+				this->m_last->SetValue(p_param);
+				return TRUE;
+			}
+		}
+
+		return FALSE;
+	}
+
+	static MxBool IsMotion(NotificationId p_id) { return p_id == c_notificationMouseMove || p_id == c_notificationDrag; }
+};
 
 // VTABLE: LEGO1 0x100d6a20
 // class MxCollection<MxCore*>
@@ -69,6 +89,15 @@ class LegoNotifyListCursor : public MxPtrListCursor<MxCore> {
 // SIZE 0x338
 class LegoInputManager : public MxPresenter {
 public:
+	// How QueueEvent hands events to ProcessOneEvent.
+	// e_immediate: every event is processed as soon as it is queued (original behavior).
+	// e_coalesced: events are queued and processed on tickle, at most g_eventBudget per tickle.
+	//              Consecutive mouse moves are merged, so only the latest position is processed.
+	enum EventMode {
+		e_immediate = 0,
+		e_coalesced
+	};
+
 	enum Keys {
 		c_left = 0x01,
 		c_right = 0x02,
@@ -132,15 +161,27 @@ class LegoInputManager : public MxPresenter {
 	LegoCameraController* GetCamera() { return m_camera; }
 
 	void ProcessEvents();
+	void SetEventMode(EventMode p_mode);
 	MxBool ProcessOneEvent(LegoEventNotificationParam& p_param);
 	MxBool FUN_1005cdf0(LegoEventNotificationParam& p_param);
 	void GetKeyboardState();
 	MxResult GetNavigationKeyStates(MxU32& p_keyFlags);
 
+	static EventMode GetEventMode() { return g_eventMode; }
+	static void SetEventBudget(MxU32 p_eventBudget) { g_eventBudget = p_eventBudget; }
+	static MxU32 GetNumMergedEvents() { return g_numMergedEvents; }
+	static MxU32 GetNumDeferredEvents() { return g_numDeferredEvents; }
+
 	// SYNTHETIC: LEGO1 0x1005b8d0
 	// LegoInputManager::`scalar deleting destructor'
 
 private:
+	static EventMode g_eventMode;
+	static MxU32 g_eventBudget;
+	static MxU32 g_numMergedEvents;
+	static MxU32 g_numDeferredEvents;
+	static MxU32 g_numCountedEvents;
+
 	MxCriticalSection m_criticalSection;     // 0x58
 	LegoNotifyList* m_keyboardNotifyList;    // 0x5c
 	LegoCameraController* m_camera;          // 0x60
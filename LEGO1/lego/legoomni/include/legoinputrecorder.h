@@ -0,0 +1,93 @@
+#ifndef LEGOINPUTRECORDER_H
+#define LEGOINPUTRECORDER_H
+
+#include "decomp.h"
+#include "mxcore.h"
+#include "mxnotificationparam.h"
+#include "mxtypes.h"
+
+class LegoFile;
+
+// Records the events passed to LegoInputManager::QueueEvent, together with their
+// MxTimer timestamps, and plays them back with the same timing. The navigation
+// keys polled through LegoInputManager::GetNavigationKeyStates are recorded
+// whenever they change, and replace the polled state during playback.
+// This allows a session to be reproduced without anybody at the keyboard.
+// The log is chosen with SetLog before the input manager is created.
+// Not part of the original game.
+// SIZE 0x34
+class LegoInputRecorder : public MxCore {
+public:
+	enum State {
+		e_idle = 0,
+		e_recording,
+		e_playing
+	};
+
+	enum {
+		c_magic = 0x4c52494c, // "LIRL"
+		c_version = 1,
+		c_keyStates = 0xffff // Event id of a change of the polled navigation keys
+	};
+
+	// One recorded event. The time is relative to the start of the recording.
+	// SIZE 0x14
+	struct Event {
+		MxLong m_time;   // 0x00
+		MxU16 m_id;      // 0x04
+		MxU8 m_modifier; // 0x06
+		MxLong m_x;      // 0x08
+		MxLong m_y;      // 0x0c
+		MxU8 m_key;      // 0x10
+	};
+
+	LegoInputRecorder();
+	~LegoInputRecorder() override;
+
+	MxResult Tickle() override; // vtable+0x08
+
+	const char* ClassName() const override // vtable+0x0c
+	{
+		return "LegoInputRecorder";
+	}
+
+	MxBool IsA(const char* p_name) const override // vtable+0x10
+	{
+		return !strcmp(p_name, LegoInputRecorder::ClassName()) || MxCore::IsA(p_name);
+	}
+
+	MxResult StartRecording(const char* p_filename);
+	MxResult StartPlayback(const char* p_filename);
+	void Stop();
+	MxBool FilterEvent(NotificationId p_id, MxU8 p_modifier, MxLong p_x, MxLong p_y, MxU8 p_key);
+	void FilterKeyStates(MxU32& p_keyFlags);
+
+	State GetState() const { return m_state; }
+	MxU32 GetNumEvents() const { return m_numEvents; }
+
+	static void SetLog(const char* p_filename, MxBool p_playback);
+	static void Startup();
+	static void Shutdown();
+	static LegoInputRecorder* GetActive() { return g_activeRecorder; }
+
+private:
+	MxResult Open(const char* p_filename, MxU32 p_mode);
+	MxResult WriteEvent(Event& p_event);
+	MxResult ReadEvent(Event& p_event);
+
+	static LegoInputRecorder* g_activeRecorder;
+	static LegoInputRecorder* g_logRecorder;
+	static char* g_logFilename;
+	static MxBool g_logPlayback;
+
+	State m_state;        // 0x08
+	LegoFile* m_file;     // 0x0c
+	MxLong m_startTime;   // 0x10
+	Event m_nextEvent;    // 0x14
+	MxBool m_hasNext;     // 0x28
+	MxBool m_dispatching; // 0x29
+	MxU32 m_numEvents;    // 0x2c
+	MxU32 m_keyFlags;     // 0x30
+};
+
+#endif // LEGOINPUTRECORDER_H
@@ -0,0 +1,88 @@
+#ifndef LEGONAMEHASH_H
+#define LEGONAMEHASH_H
+
+#include "mxstl/stlcompat.h"
+#include "mxtypes.h"
+
+#include <ctype.h>
+#include <string.h>
+
+// Maps names to values, ignoring case. The names are not copied, so an entry
+// has to be removed before its name is modified, and added again afterwards.
+// A name may be added more than once, see GetBucket to visit all its values.
+// Not part of the original game.
+template <class T>
+class LegoNameHash {
+public:
+	enum {
+		c_numBuckets = 64
+	};
+
+	struct Entry {
+		const char* m_name;
+		T m_value;
+	};
+
+	typedef vector<Entry> Bucket;
+
+	static MxU32 Hash(const char* p_name)
+	{
+		MxU32 hash = 2166136261u;
+
+		while (*p_name) {
+			hash = (hash ^ (MxU8) toupper((MxU8) *p_name++)) * 16777619u;
+		}
+
+		return hash;
+	}
+
+	void Add(const char* p_name, T p_value)
+	{
+		Entry entry;
+		entry.m_name = p_name;
+		entry.m_value = p_value;
+		GetBucket(p_name).push_back(entry);
+	}
+
+	void Remove(const char* p_name, T p_value)
+	{
+		Bucket& bucket = GetBucket(p_name);
+
+		for (MxU32 i = 0; i < bucket.size(); i++) {
+			if (bucket[i].m_value == p_value && !strcmpi(bucket[i].m_name, p_name)) {
+				bucket.erase(bucket.begin() + i);
+				return;
+			}
+		}
+	}
+
+	// Finds the value that was added first under p_name
+	MxBool Find(const char* p_name, T& p_value)
+	{
+		Bucket& bucket = GetBucket(p_name);
+
+		for (MxU32 i = 0; i < bucket.size(); i++) {
+			if (!strcmpi(bucket[i].m_name, p_name)) {
+				p_value = bucket[i].m_value;
+				return TRUE;
+			}
+		}
+
+		return FALSE;
+	}
+
+	// The bucket also holds the entries of other names with the same hash
+	Bucket& GetBucket(const char* p_name) { return m_buckets[Hash(p_name) & (c_numBuckets - 1)]; }
+
+	void Clear()
+	{
+		for (MxS32 i = 0; i < c_numBuckets; i++) {
+			m_buckets[i].erase(m_buckets[i].begin(), m_buckets[i].end());
+		}
+	}
+
+private:
+	Bucket m_buckets[c_numBuckets];
+};
+
+#endif // LEGONAMEHASH_H
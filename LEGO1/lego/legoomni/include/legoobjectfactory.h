@@ -114,6 +114,9 @@ class LegoObjectFactory : public MxObjectFactory {
 	MxCore* Create(const char* p_name) override; // vtable+0x14
 	void Destroy(MxCore* p_object) override;     // vtable+0x18
 
+	// Not part of the original game
+	static MxObjectFactoryTable& GetTable() { return g_table; }
+
 	// SYNTHETIC: LEGO1 0x10009000
 	// LegoObjectFactory::`scalar deleting destructor'
 
@@ -124,6 +127,8 @@ class LegoObjectFactory : public MxObjectFactory {
 #define X(V) MxAtomId m_id##V;
 	FOR_LEGOOBJECTFACTORY_OBJECTS(X)
 #undef X
+
+	static MxObjectFactoryTable g_table;
 };
 
 #endif // LEGOOBJECTFACTORY_H
@@ -0,0 +1,84 @@
+#ifndef LEGOSAVEWRITER_H
+#define LEGOSAVEWRITER_H
+
+#include "decomp.h"
+#include "mxcriticalsection.h"
+#include "mxsemaphore.h"
+#include "mxstl/stlcompat.h"
+#include "mxstring.h"
+#include "mxthread.h"
+#include "mxtypes.h"
+
+class LegoMemoryBuffer;
+class LegoSaveWriter;
+
+// Not part of the original game.
+// SIZE 0x20
+class LegoSaveWriterThread : public MxThread {
+public:
+	LegoSaveWriterThread() : MxThread() { m_writer = NULL; }
+
+	MxResult Run() override;
+	MxResult StartWithWriter(LegoSaveWriter* p_writer);
+
+private:
+	LegoSaveWriter* m_writer; // 0x1c
+};
+
+// Writes save games on a worker thread, so saving does not stall the game.
+// A save is serialized into memory first and handed over as a whole. It is
+// skipped if it is identical to the last one submitted for the same file.
+// Otherwise it is written to a temporary file, which then replaces the save
+// in one step, so an interrupted write never leaves a truncated save behind.
+// Anything that reads or moves save files has to call Flush first.
+// Not part of the original game.
+// SIZE 0x84
+class LegoSaveWriter {
+public:
+	// SIZE 0x18
+	struct File {
+		MxString m_path; // 0x00
+		MxU8* m_data;    // 0x10
+		MxU32 m_size;    // 0x14
+	};
+
+	LegoSaveWriter();
+	~LegoSaveWriter();
+
+	MxResult Create();
+	void Destroy();
+
+	MxResult Submit(const char* p_path, LegoMemoryBuffer& p_storage);
+	void Flush();
+	void ForgetSnapshots();
+	void WriteFiles();
+
+	MxU32 GetNumWritten() { return m_numWritten; }
+	MxU32 GetNumSkipped() { return m_numSkipped; }
+	MxU32 GetNumFailed() { return m_numFailed; }
+	MxU32 GetBytesWritten() { return m_bytesWritten; }
+
+private:
+	typedef vector<File*> FileVector;
+
+	static MxResult WriteFile(File* p_file);
+	static void DeleteFiles(FileVector& p_files);
+
+	File* FindSnapshot(const char* p_path);
+	void RemoveSnapshot(const char* p_path);
+
+	FileVector m_pending;          // 0x00
+	FileVector m_snapshots;        // 0x10
+	MxS32 m_numWriting;            // 0x20
+	MxBool m_running;              // 0x24
+	MxCriticalSection m_lock;      // 0x28
+	MxSemaphore m_workSemaphore;   // 0x44
+	MxSemaphore m_doneSemaphore;   // 0x4c
+	LegoSaveWriterThread m_thread; // 0x54
+	MxU32 m_numWritten;            // 0x74
+	MxU32 m_numSkipped;            // 0x78
+	MxU32 m_numFailed;             // 0x7c
+	MxU32 m_bytesWritten;          // 0x80
+};
+
+#endif // LEGOSAVEWRITER_H
@@ -8,6 +8,7 @@
 #include <ddraw.h>
 
 class LegoTexture;
+class MxRect32;
 
 // SIZE 0x10
 class LegoTextureInfo {
@@ -21,11 +22,31 @@ class LegoTextureInfo {
 
 	LegoResult FUN_10066010(const LegoU8* p_bits);
 
+	// Not part of the original game.
+	// Partial uploads: the rects are in image coordinates, top row first, and
+	// inclusive like MxRect32. With p_bottomUp, the rows of p_bits are stored
+	// bottom row first, as in a bottom-up DIB.
+	void AddDirtyRect(const MxRect32& p_rect);
+	LegoResult LoadDirtyBits(const LegoU8* p_bits, LegoBool p_bottomUp);
+	LegoResult LoadBits(const LegoU8* p_bits, const MxRect32* p_rects, LegoS32 p_rectCount, LegoBool p_bottomUp);
+
+	static LegoU32 GetBytesCopied() { return g_bytesCopied; }
+	static LegoU32 GetBytesSkipped() { return g_bytesSkipped; }
+	static void ResetStatistics()
+	{
+		g_bytesCopied = 0;
+		g_bytesSkipped = 0;
+	}
+
 	// private:
 	char* m_name;                   // 0x00
 	LPDIRECTDRAWSURFACE m_surface;  // 0x04
 	LPDIRECTDRAWPALETTE m_palette;  // 0x08
 	LPDIRECT3DRMTEXTURE2 m_texture; // 0x0c
+
+private:
+	static LegoU32 g_bytesCopied;
+	static LegoU32 g_bytesSkipped;
 };
 
 // GLOBAL: LEGO1 0x100db6f0
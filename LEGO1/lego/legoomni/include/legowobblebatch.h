@@ -0,0 +1,53 @@
+#ifndef LEGOWOBBLEBATCH_H
+#define LEGOWOBBLEBATCH_H
+
+#include "decomp.h"
+#include "mxtypes.h"
+
+class LegoEntity;
+class LegoROI;
+
+// The plants or buildings that wobble after they were clicked, kept in parallel
+// arrays. Each tick, Advance and ComputeWave evaluate all wobbles in one pass
+// each, before the managers apply the results to the ROIs. Entries are removed
+// by moving the last one into their place, so a manager can remove finished
+// entries while walking the arrays backwards without skipping any.
+// Not part of the original game.
+// SIZE 0x2a4
+class LegoWobbleBatch {
+public:
+	enum {
+		c_maxEntries = 32,
+		c_startDelay = 1000
+	};
+
+	LegoWobbleBatch() { m_count = 0; }
+
+	MxResult Add(LegoEntity* p_entity, MxLong p_endTime, float p_height, MxBool p_muted);
+	void Remove(MxS32 p_index);
+	void Advance(MxLong p_time);
+	void ComputeWave(MxS32 p_speed, float p_amplitude, float* p_wave);
+
+	void Clear() { m_count = 0; }
+
+	MxS32 GetCount() { return m_count; }
+	LegoEntity* GetEntity(MxS32 p_index) { return m_entities[p_index]; }
+	LegoROI* GetROI(MxS32 p_index) { return m_rois[p_index]; }
+	float& GetHeight(MxS32 p_index) { return m_heights[p_index]; }
+	MxBool& GetMuted(MxS32 p_index) { return m_muted[p_index]; }
+
+	// Valid after Advance
+	MxBool IsStarted(MxS32 p_index) { return m_timeLeft[p_index] <= c_startDelay; }
+	MxBool IsFinished(MxS32 p_index) { return m_timeLeft[p_index] < 0; }
+
+private:
+	LegoEntity* m_entities[c_maxEntries]; // 0x000
+	LegoROI* m_rois[c_maxEntries];        // 0x080
+	MxLong m_endTimes[c_maxEntries];      // 0x100
+	MxLong m_timeLeft[c_maxEntries];      // 0x180
+	float m_heights[c_maxEntries];        // 0x200
+	MxBool m_muted[c_maxEntries];         // 0x280
+	MxS32 m_count;                        // 0x2a0
+};
+
+#endif // LEGOWOBBLEBATCH_H
@@ -49,6 +49,30 @@ class MxTransitionManager : public MxCore {
 
 	TransitionType GetTransitionType() { return m_mode; }
 
+	// Not part of the original game.
+	// The effect kernels work on a plain pixel buffer with 1, 2 or 4 bytes per pixel,
+	// so they do not depend on a locked DirectDraw surface.
+	static void DissolveKernel(
+		MxU8* p_pixels,
+		MxS32 p_pitch,
+		MxS32 p_bytesPerPixel,
+		const MxU16* p_columns,
+		MxS32 p_numColumns,
+		const MxU16* p_randomShift
+	);
+	static void MosaicKernel(
+		MxU8* p_pixels,
+		MxS32 p_pitch,
+		MxS32 p_bytesPerPixel,
+		const MxU16* p_blocks,
+		MxS32 p_numBlocks,
+		const MxU16* p_randomShift
+	);
+	static void WipeDownKernel(MxU8* p_pixels, MxS32 p_pitch, MxS32 p_bytesPerPixel, MxS32 p_step);
+	static void WindowsKernel(MxU8* p_pixels, MxS32 p_pitch, MxS32 p_bytesPerPixel, MxS32 p_step);
+
+	static void SetRandomSeed(MxU32 p_seed) { g_randomState = p_seed != 0 ? p_seed : 0x2545f491; }
+
 	// SYNTHETIC: LEGO1 0x1004b9e0
 	// MxTransitionManager::`scalar deleting destructor'
 
@@ -64,6 +88,10 @@ class MxTransitionManager : public MxCore {
 	void SubmitCopyRect(LPDDSURFACEDESC p_ddsc);
 	void SetupCopyRect(LPDDSURFACEDESC p_ddsc);
 
+	static MxU32 Random();
+
+	static MxU32 g_randomState;
+
 	MxVideoPresenter* m_waitIndicator; // 0x08
 	RECT m_copyRect;                   // 0x0c
 	MxU8* m_copyBuffer;                // 0x1c
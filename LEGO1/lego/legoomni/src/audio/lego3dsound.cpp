@@ -1,5 +1,6 @@
 #include "lego3dsound.h"
 
+#include "lego3dsoundupdater.h"
 #include "legoactor.h"
 #include "legocharactermanager.h"
 #include "legosoundmanager.h"
@@ -41,7 +42,7 @@ MxResult Lego3DSound::Create(LPDIRECTSOUNDBUFFER p_directSoundBuffer, const char
 {
 	m_volume = p_volume;
 
-	if (MxOmni::IsSound3D()) {
+	if (MxSoundManager::IsSound3D()) {
 		p_directSoundBuffer->QueryInterface(IID_IDirectSound3DBuffer, (LPVOID*) &m_ds3dBuffer);
 		if (m_ds3dBuffer == NULL) {
 			return FAILURE;
@@ -84,11 +85,15 @@ MxResult Lego3DSound::Create(LPDIRECTSOUNDBUFFER p_directSoundBuffer, const char
 		m_positionROI = m_roi;
 	}
 
-	if (MxOmni::IsSound3D()) {
+	if (MxSoundManager::IsSound3D()) {
 		const float* position = m_positionROI->GetWorldPosition();
 		m_ds3dBuffer->SetPosition(position[0], position[1], position[2], DS3D_IMMEDIATE);
 	}
 
+	if (m_positionROI != NULL) {
+		Lego3DSoundUpdater::GetInstance()->Add(this, p_directSoundBuffer);
+	}
+
 	LegoEntity* entity = m_roi->GetEntity();
 	if (entity != NULL && entity->IsA("LegoActor") && ((LegoActor*) entity)->GetSoundFrequencyFactor() != 0.0f) {
 		m_actor = ((LegoActor*) entity);
@@ -110,6 +115,8 @@ MxResult Lego3DSound::Create(LPDIRECTSOUNDBUFFER p_directSoundBuffer, const char
 // FUNCTION: LEGO1 0x10011880
 void Lego3DSound::Destroy()
 {
+	Lego3DSoundUpdater::GetInstance()->Remove(this);
+
 	if (m_ds3dBuffer) {
 		m_ds3dBuffer->Release();
 		m_ds3dBuffer = NULL;
@@ -134,6 +141,19 @@ MxU32 Lego3DSound::UpdatePosition(LPDIRECTSOUNDBUFFER p_directSoundBuffer)
 	MxU32 updated = FALSE;
 
 	if (m_positionROI != NULL) {
+		// Evaluated in the batched pass, unless the updater had no room for this sound
+		Lego3DSoundUpdater::Result result = Lego3DSoundUpdater::GetInstance()->GetResult(this);
+
+		if (result == Lego3DSoundUpdater::e_inaudible) {
+			return FALSE;
+		}
+
+		if (result == Lego3DSoundUpdater::e_audible) {
+			updated = TRUE;
+		}
+	}
+
+	if (m_positionROI != NULL && !updated) {
 		const float* position = m_positionROI->GetWorldPosition();
 
 		ViewROI* pov = VideoManager()->GetViewROI();
@@ -150,20 +170,7 @@ MxU32 Lego3DSound::UpdatePosition(LPDIRECTSOUNDBUFFER p_directSoundBuffer)
 			m_ds3dBuffer->SetPosition(position[0], position[1], position[2], DS3D_IMMEDIATE);
 		}
 		else {
-			MxS32 newVolume = m_volume;
-			if (distance < 100.0f) {
-				newVolume = m_volume;
-			}
-			else if (distance < 400.0f) {
-				newVolume *= 0.4;
-			}
-			else if (distance < 3600.0f) {
-				newVolume *= 0.1;
-			}
-			else if (distance < 10000.0f) {
-				newVolume = 0;
-			}
-
+			MxS32 newVolume = m_volume * Lego3DSoundUpdater::GetDistanceFactor(distance);
 			newVolume = newVolume * SoundManager()->GetVolume() / 100;
 			newVolume = SoundManager()->GetAttenuation(newVolume);
 			p_directSoundBuffer->SetVolume(newVolume);
@@ -241,20 +248,7 @@ void Lego3DSound::FUN_10011a60(LPDIRECTSOUNDBUFFER p_directSoundBuffer, const ch
 				const float* povPosition = pov->GetWorldPosition();
 				float distance = DISTSQRD3(povPosition, position);
 
-				MxS32 newVolume;
-				if (distance < 100.0f) {
-					newVolume = m_volume;
-				}
-				else if (distance < 400.0f) {
-					newVolume = m_volume * 0.4;
-				}
-				else if (distance < 3600.0f) {
-					newVolume = m_volume * 0.1;
-				}
-				else {
-					newVolume = 0;
-				}
-
+				MxS32 newVolume = m_volume * Lego3DSoundUpdater::GetDistanceFactor(distance);
 				newVolume = newVolume * SoundManager()->GetVolume() / 100;
 				newVolume = SoundManager()->GetAttenuation(newVolume);
 				p_directSoundBuffer->SetVolume(newVolume);
@@ -275,12 +269,18 @@ void Lego3DSound::FUN_10011a60(LPDIRECTSOUNDBUFFER p_directSoundBuffer, const ch
 				p_directSoundBuffer->SetFrequency(m_frequencyFactor * m_dwFrequency);
 			}
 		}
+
+		if (m_positionROI != NULL) {
+			Lego3DSoundUpdater::GetInstance()->Add(this, p_directSoundBuffer);
+		}
 	}
 }
 
 // FUNCTION: LEGO1 0x10011ca0
 void Lego3DSound::Reset()
 {
+	Lego3DSoundUpdater::GetInstance()->Remove(this);
+
 	if (m_enabled && m_roi && CharacterManager()) {
 		if (m_isActor) {
 			CharacterManager()->ReleaseActor(m_roi);
@@ -298,7 +298,7 @@ void Lego3DSound::Reset()
 // FUNCTION: LEGO1 0x10011cf0
 MxS32 Lego3DSound::SetDistance(MxS32 p_min, MxS32 p_max)
 {
-	if (MxOmni::IsSound3D()) {
+	if (MxSoundManager::IsSound3D()) {
 		if (m_ds3dBuffer == NULL) {
 			return -1;
 		}
@@ -0,0 +1,217 @@
+#include "lego3dsoundupdater.h"
+
+#include "lego3dsound.h"
+#include "legosoundmanager.h"
+#include "legovideomanager.h"
+#include "misc.h"
+#include "roi/legoroi.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+DECOMP_SIZE_ASSERT(Lego3DSoundUpdater, 0xb4c)
+
+// Not part of the original game.
+// Squared distance a sound has to move before its new position is pushed
+const float g_positionThreshold = 0.05f * 0.05f;
+
+Lego3DSoundUpdater::Lego3DSoundUpdater()
+{
+	m_numSounds = 0;
+	ResetStatistics();
+}
+
+Lego3DSoundUpdater* Lego3DSoundUpdater::GetInstance()
+{
+	static Lego3DSoundUpdater g_instance;
+	return &g_instance;
+}
+
+// Full volume up to a distance of 10, then falling off with the distance and
+// fading out completely at 100, past which a sound is not played at all.
+// This follows the steps of the original table (1, 0.4, 0.1, 0) without its jumps.
+float Lego3DSoundUpdater::GetDistanceFactor(float p_distanceSquared)
+{
+	if (p_distanceSquared <= 100.0f) {
+		return 1.0f;
+	}
+
+	if (p_distanceSquared >= 10000.0f) {
+		return 0.0f;
+	}
+
+	float distance = sqrt(p_distanceSquared);
+	return (10.0f / distance) * ((100.0f - distance) / 90.0f);
+}
+
+// Adding a sound again resets it, e.g. after it was moved to another ROI
+MxResult Lego3DSoundUpdater::Add(Lego3DSound* p_sound, LPDIRECTSOUNDBUFFER p_buffer)
+{
+	MxS32 i;
+
+	for (i = 0; i < m_numSounds; i++) {
+		if (m_sounds[i] == p_sound) {
+			break;
+		}
+	}
+
+	if (i == c_maxSounds) {
+		return FAILURE;
+	}
+
+	if (i == m_numSounds) {
+		m_numSounds++;
+	}
+
+	m_sounds[i] = p_sound;
+	m_buffers[i] = p_buffer;
+	m_states[i] = 0;
+	return SUCCESS;
+}
+
+void Lego3DSoundUpdater::Remove(Lego3DSound* p_sound)
+{
+	for (MxS32 i = 0; i < m_numSounds; i++) {
+		if (m_sounds[i] == p_sound) {
+			// Keep the arrays dense by moving the last sound into the gap
+			m_numSounds--;
+			m_sounds[i] = m_sounds[m_numSounds];
+			m_buffers[i] = m_buffers[m_numSounds];
+			m_x[i] = m_x[m_numSounds];
+			m_y[i] = m_y[m_numSounds];
+			m_z[i] = m_z[m_numSounds];
+			m_distances[i] = m_distances[m_numSounds];
+			m_pushedX[i] = m_pushedX[m_numSounds];
+			m_pushedY[i] = m_pushedY[m_numSounds];
+			m_pushedZ[i] = m_pushedZ[m_numSounds];
+			m_volumes[i] = m_volumes[m_numSounds];
+			m_pushedVolumes[i] = m_pushedVolumes[m_numSounds];
+			m_states[i] = m_states[m_numSounds];
+			return;
+		}
+	}
+}
+
+// Called once per sound manager tick
+void Lego3DSoundUpdater::Update()
+{
+	Evaluate(0, m_numSounds);
+}
+
+// Pushes the sound's evaluated position or volume. Only called for sounds whose
+// owner updates them, so a muted or stopped sound keeps the volume it was given.
+Lego3DSoundUpdater::Result Lego3DSoundUpdater::GetResult(Lego3DSound* p_sound)
+{
+	for (MxS32 i = 0; i < m_numSounds; i++) {
+		if (m_sounds[i] == p_sound) {
+			if (!(m_states[i] & c_evaluated)) {
+				Evaluate(i, i + 1);
+			}
+
+			if (!(m_states[i] & c_audible)) {
+				return e_inaudible;
+			}
+
+			Push(i);
+			return e_audible;
+		}
+	}
+
+	return e_notAdded;
+}
+
+// Called when the sound's buffer volume was set elsewhere, so the next update
+// pushes its volume again
+void Lego3DSoundUpdater::Invalidate(Lego3DSound* p_sound)
+{
+	for (MxS32 i = 0; i < m_numSounds; i++) {
+		if (m_sounds[i] == p_sound) {
+			m_states[i] &= ~c_pushed;
+			return;
+		}
+	}
+}
+
+void Lego3DSoundUpdater::Evaluate(MxS32 p_begin, MxS32 p_end)
+{
+	MxS32 i;
+	ViewROI* pov = VideoManager()->GetViewROI();
+
+	if (pov == NULL) {
+		for (i = p_begin; i < p_end; i++) {
+			m_states[i] = (m_states[i] & ~c_audible) | c_evaluated;
+		}
+
+		return;
+	}
+
+	const float* povPosition = pov->GetWorldPosition();
+	float listenerX = povPosition[0];
+	float listenerY = povPosition[1];
+	float listenerZ = povPosition[2];
+
+	for (i = p_begin; i < p_end; i++) {
+		const float* position = m_sounds[i]->GetPositionROI()->GetWorldPosition();
+		m_x[i] = position[0];
+		m_y[i] = position[1];
+		m_z[i] = position[2];
+	}
+
+	for (i = p_begin; i < p_end; i++) {
+		float dx = m_x[i] - listenerX;
+		float dy = m_y[i] - listenerY;
+		float dz = m_z[i] - listenerZ;
+		m_distances[i] = dx * dx + dy * dy + dz * dz;
+	}
+
+	MxS32 soundVolume = SoundManager()->GetVolume();
+
+	for (i = p_begin; i < p_end; i++) {
+		if (m_distances[i] > 10000.0f) {
+			m_states[i] = (m_states[i] & ~c_audible) | c_evaluated;
+			continue;
+		}
+
+		m_states[i] |= c_evaluated | c_audible;
+
+		if (m_sounds[i]->GetDS3DBuffer() == NULL) {
+			MxS32 volume = m_sounds[i]->GetVolume() * GetDistanceFactor(m_distances[i]);
+			m_volumes[i] = SoundManager()->GetAttenuation(volume * soundVolume / 100);
+		}
+	}
+}
+
+void Lego3DSoundUpdater::Push(MxS32 p_index)
+{
+	LPDIRECTSOUND3DBUFFER ds3dBuffer = m_sounds[p_index]->GetDS3DBuffer();
+
+	if (ds3dBuffer != NULL) {
+		float dx = m_x[p_index] - m_pushedX[p_index];
+		float dy = m_y[p_index] - m_pushedY[p_index];
+		float dz = m_z[p_index] - m_pushedZ[p_index];
+
+		if ((m_states[p_index] & c_pushed) && dx * dx + dy * dy + dz * dz < g_positionThreshold) {
+			m_driverCallsSaved++;
+			return;
+		}
+
+		ds3dBuffer->SetPosition(m_x[p_index], m_y[p_index], m_z[p_index], DS3D_IMMEDIATE);
+		m_pushedX[p_index] = m_x[p_index];
+		m_pushedY[p_index] = m_y[p_index];
+		m_pushedZ[p_index] = m_z[p_index];
+	}
+	else {
+		MxS32 volume = m_volumes[p_index];
+
+		if ((m_states[p_index] & c_pushed) && abs(volume - m_pushedVolumes[p_index]) < c_volumeThreshold) {
+			m_driverCallsSaved++;
+			return;
+		}
+
+		m_buffers[p_index]->SetVolume(volume);
+		m_pushedVolumes[p_index] = volume;
+	}
+
+	m_states[p_index] |= c_pushed;
+	m_driverCalls++;
+}
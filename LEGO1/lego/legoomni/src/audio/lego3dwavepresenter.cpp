@@ -1,8 +1,10 @@
 #include "lego3dwavepresenter.h"
 
+#include "lego3dsoundupdater.h"
 #include "mxcompositepresenter.h"
 #include "mxdsaction.h"
 #include "mxomni.h"
+#include "mxsoundmanager.h"
 
 DECOMP_SIZE_ASSERT(Lego3DWavePresenter, 0xa0)
 
@@ -12,7 +14,7 @@ MxResult Lego3DWavePresenter::AddToManager()
 	MxResult result = MxWavePresenter::AddToManager();
 	MxWavePresenter::Init();
 
-	if (MxOmni::IsSound3D()) {
+	if (MxSoundManager::IsSound3D()) {
 		m_is3d = TRUE;
 	}
 
@@ -25,7 +27,7 @@ void Lego3DWavePresenter::Destroy()
 	MxWavePresenter::Destroy();
 	MxWavePresenter::Init();
 
-	if (MxOmni::IsSound3D()) {
+	if (MxSoundManager::IsSound3D()) {
 		m_is3d = TRUE;
 	}
 }
@@ -34,7 +36,7 @@ void Lego3DWavePresenter::Destroy()
 // FUNCTION: BETA10 0x1003a3b0
 void Lego3DWavePresenter::StartingTickle()
 {
-	if (MxOmni::IsSound3D()) {
+	if (MxSoundManager::IsSound3D()) {
 		m_is3d = TRUE;
 	}
 
@@ -64,3 +66,10 @@ void Lego3DWavePresenter::StreamingTickle()
 	MxWavePresenter::StreamingTickle();
 	m_sound.UpdatePosition(m_dsBuffer);
 }
+
+// The distance volume of a 2D sound is pushed again on the next update
+void Lego3DWavePresenter::SetVolume(MxS32 p_volume)
+{
+	MxWavePresenter::SetVolume(p_volume);
+	Lego3DSoundUpdater::GetInstance()->Invalidate(&m_sound);
+}
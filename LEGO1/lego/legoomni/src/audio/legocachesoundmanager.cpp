@@ -2,6 +2,7 @@
 
 #include "legoworld.h"
 #include "misc.h"
+#include "mxdebug.h"
 
 DECOMP_SIZE_ASSERT(LegoCacheSoundEntry, 0x08)
 DECOMP_SIZE_ASSERT(LegoCacheSoundManager, 0x20)
@@ -63,10 +64,7 @@ MxResult LegoCacheSoundManager::Tickle()
 // FUNCTION: LEGO1 0x1003d170
 LegoCacheSound* LegoCacheSoundManager::FindSoundByKey(const char* p_key)
 {
-	char* key = new char[strlen(p_key) + 1];
-	strcpy(key, p_key);
-
-	Set100d6b4c::iterator it = m_set.find(LegoCacheSoundEntry(NULL, key));
+	Set100d6b4c::iterator it = m_set.find(LegoCacheSoundEntry(NULL, p_key));
 	if (it != m_set.end()) {
 		return (*it).GetSound();
 	}
@@ -92,6 +90,14 @@ LegoCacheSound* LegoCacheSoundManager::ManageSoundEntry(LegoCacheSound* p_sound)
 	}
 
 	m_set.insert(LegoCacheSoundEntry(p_sound));
+	MxTrace(
+		"Cached sound %s: %u sounds, %u clones, %u bytes of samples\n",
+		p_sound->GetUnknown0x48().GetData(),
+		m_set.size(),
+		m_list.size(),
+		LegoCacheSound::GetSampleMemory()
+	);
+
 	LegoWorld* world = CurrentWorld();
 	if (world) {
 		world->Add(p_sound);
@@ -1,5 +1,6 @@
 #include "legocachsound.h"
 
+#include "lego3dsoundupdater.h"
 #include "legosoundmanager.h"
 #include "misc.h"
 #include "mxomni.h"
@@ -8,6 +9,33 @@
 
 DECOMP_SIZE_ASSERT(LegoCacheSound, 0x88)
 
+// Not part of the original game.
+MxU32 LegoCacheSound::g_sampleMemory = 0;
+
+// Sample data is never modified after it has been copied, so a sound and all of
+// its clones share a single buffer. The reference count is stored in front of the samples.
+inline MxU8* AllocSharedData(MxU32 p_dataSize)
+{
+	MxU8* block = new MxU8[sizeof(LONG) + p_dataSize];
+	*(LONG*) block = 1;
+	return block + sizeof(LONG);
+}
+
+inline void AddRefSharedData(MxU8* p_data)
+{
+	InterlockedIncrement((LONG*) (p_data - sizeof(LONG)));
+}
+
+inline MxBool ReleaseSharedData(MxU8* p_data)
+{
+	if (p_data != NULL && InterlockedDecrement((LONG*) (p_data - sizeof(LONG))) == 0) {
+		delete[] (p_data - sizeof(LONG));
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
 // FUNCTION: LEGO1 0x100064d0
 // FUNCTION: BETA10 0x10066340
 LegoCacheSound::LegoCacheSound()
@@ -62,7 +90,7 @@ MxResult LegoCacheSound::Create(
 	memset(&desc, 0, sizeof(desc));
 	desc.dwSize = sizeof(desc);
 
-	if (MxOmni::IsSound3D()) {
+	if (MxSoundManager::IsSound3D()) {
 		desc.dwFlags =
 			DSBCAPS_STATIC | DSBCAPS_LOCSOFTWARE | DSBCAPS_CTRL3D | DSBCAPS_CTRLFREQUENCY | DSBCAPS_CTRLVOLUME;
 	}
@@ -73,7 +101,7 @@ MxResult LegoCacheSound::Create(
 	desc.dwBufferBytes = p_dataSize;
 	desc.lpwfxFormat = &wfx;
 
-	if (SoundManager()->GetDirectSound()->CreateSoundBuffer(&desc, &m_dsBuffer, NULL) != DS_OK) {
+	if (SoundManager()->CreateSoundBuffer(&desc, &m_dsBuffer) != SUCCESS) {
 		return FAILURE;
 	}
 
@@ -91,6 +119,7 @@ MxResult LegoCacheSound::Create(
 
 	if (p_data != NULL && p_dataSize != 0) {
 		CopyData(p_data, p_dataSize);
+		FillBuffer();
 	}
 
 	m_unk0x48 = GetBaseFilename(p_mediaSrcPath);
@@ -105,10 +134,81 @@ void LegoCacheSound::CopyData(MxU8* p_data, MxU32 p_dataSize)
 	assert(p_data);
 	assert(p_dataSize);
 
-	delete[] m_data;
+	ReleaseData();
 	m_dataSize = p_dataSize;
-	m_data = new MxU8[m_dataSize];
+	m_data = AllocSharedData(m_dataSize);
 	memcpy(m_data, p_data, m_dataSize);
+	g_sampleMemory += m_dataSize;
+}
+
+void LegoCacheSound::ShareData(MxU8* p_data, MxU32 p_dataSize)
+{
+	assert(p_data);
+	assert(p_dataSize);
+
+	AddRefSharedData(p_data);
+	ReleaseData();
+	m_dataSize = p_dataSize;
+	m_data = p_data;
+}
+
+void LegoCacheSound::ReleaseData()
+{
+	if (ReleaseSharedData(m_data)) {
+		g_sampleMemory -= m_dataSize;
+	}
+
+	m_data = NULL;
+}
+
+// Copies the samples into the sound buffer. Clones play the same buffer memory,
+// so this is only needed once, or again after the buffer was lost.
+MxResult LegoCacheSound::FillBuffer()
+{
+	LPVOID pvAudioPtr1, pvAudioPtr2;
+	DWORD dwAudioBytes1, dwAudioBytes2;
+
+	if (m_dsBuffer->Lock(0, m_dataSize, &pvAudioPtr1, &dwAudioBytes1, &pvAudioPtr2, &dwAudioBytes2, 0) != DS_OK) {
+		return FAILURE;
+	}
+
+	memcpy(pvAudioPtr1, m_data, dwAudioBytes1);
+
+	if (dwAudioBytes2 != 0) {
+		memcpy(pvAudioPtr2, m_data + dwAudioBytes1, dwAudioBytes2);
+	}
+
+	DWORD sts = m_dsBuffer->Unlock(pvAudioPtr1, dwAudioBytes1, pvAudioPtr2, dwAudioBytes2);
+	assert(!sts);
+	return SUCCESS;
+}
+
+// Plays the buffer memory of p_source instead of copying its samples
+MxResult LegoCacheSound::CreateDuplicate(LegoCacheSound* p_source)
+{
+	if (p_source->m_data == NULL || p_source->m_dataSize == 0 ||
+		SoundManager()->DuplicateSoundBuffer(p_source->m_dsBuffer, &m_dsBuffer) != SUCCESS) {
+		return FAILURE;
+	}
+
+	m_volume = p_source->m_volume;
+
+	MxS32 volume = m_volume * SoundManager()->GetVolume() / 100;
+	MxS32 attenuation = SoundManager()->GetAttenuation(volume);
+	m_dsBuffer->SetVolume(attenuation);
+
+	if (m_sound.Create(m_dsBuffer, NULL, m_volume) != SUCCESS) {
+		m_dsBuffer->Release();
+		m_dsBuffer = NULL;
+		return FAILURE;
+	}
+
+	// Kept to fill the buffer again if it is lost
+	ShareData(p_source->m_data, p_source->m_dataSize);
+
+	m_unk0x48 = p_source->m_unk0x48;
+	m_wfx = p_source->m_wfx;
+	return SUCCESS;
 }
 
 // FUNCTION: LEGO1 0x10006920
@@ -121,19 +221,28 @@ void LegoCacheSound::Destroy()
 		m_dsBuffer = NULL;
 	}
 
-	delete[] m_data;
+	ReleaseData();
 	Init();
 }
 
-// FUNCTION: LEGO1 0x10006960
-// FUNCTION: BETA10 0x100668cf
 LegoCacheSound* LegoCacheSound::Clone()
 {
 	LegoCacheSound* pnew = new LegoCacheSound();
 	assert(pnew);
 
-	MxResult result = pnew->Create(&m_wfx, m_unk0x48, m_volume, m_data, m_dataSize);
+	if (pnew->CreateDuplicate(this) == SUCCESS) {
+		return pnew;
+	}
+
+	// The buffer could not be duplicated, so the clone gets its own copy of
+	// the samples in its buffer. The samples in memory are still shared.
+	MxResult result = pnew->Create(&m_wfx, m_unk0x48, m_volume, NULL, m_dataSize);
 	if (result == SUCCESS) {
+		if (m_data != NULL && m_dataSize != 0) {
+			pnew->ShareData(m_data, m_dataSize);
+			pnew->FillBuffer();
+		}
+
 		return pnew;
 	}
 	else {
@@ -142,8 +251,6 @@ LegoCacheSound* LegoCacheSound::Clone()
 	}
 }
 
-// FUNCTION: LEGO1 0x10006a30
-// FUNCTION: BETA10 0x10066a23
 MxResult LegoCacheSound::Play(const char* p_name, MxBool p_looping)
 {
 	assert(m_dsBuffer);
@@ -162,24 +269,16 @@ MxResult LegoCacheSound::Play(const char* p_name, MxBool p_looping)
 	DWORD dwStatus;
 	m_dsBuffer->GetStatus(&dwStatus);
 
-	if (dwStatus == DSBSTATUS_BUFFERLOST) {
+	// The buffer already holds the samples, unless it was lost
+	MxBool lost = dwStatus == DSBSTATUS_BUFFERLOST;
+
+	if (lost) {
 		m_dsBuffer->Restore();
 		m_dsBuffer->GetStatus(&dwStatus);
 	}
 
 	if (dwStatus != DSBSTATUS_BUFFERLOST) {
-		LPVOID pvAudioPtr1, pvAudioPtr2;
-		DWORD dwAudioBytes1, dwAudioBytes2;
-
-		if (m_dsBuffer->Lock(0, m_dataSize, &pvAudioPtr1, &dwAudioBytes1, &pvAudioPtr2, &dwAudioBytes2, 0) == DS_OK) {
-			memcpy(pvAudioPtr1, m_data, dwAudioBytes1);
-
-			if (dwAudioBytes2 != 0) {
-				memcpy(pvAudioPtr2, m_data + dwAudioBytes1, dwAudioBytes2);
-			}
-
-			DWORD sts = m_dsBuffer->Unlock(pvAudioPtr1, dwAudioBytes1, pvAudioPtr2, dwAudioBytes2);
-			assert(!sts);
+		if (!lost || FillBuffer() == SUCCESS) {
 			m_dsBuffer->SetCurrentPosition(0);
 			if (m_dsBuffer->Play(0, 0, p_looping)) {
 				assert(0);
@@ -298,6 +397,8 @@ void LegoCacheSound::MuteSilence(MxBool p_muted)
 			MxS32 attenuation = SoundManager()->GetAttenuation(volume);
 			m_dsBuffer->SetVolume(attenuation);
 		}
+
+		Lego3DSoundUpdater::GetInstance()->Invalidate(&m_sound);
 	}
 }
 
@@ -1,5 +1,6 @@
 #include "legosoundmanager.h"
 
+#include "lego3dsoundupdater.h"
 #include "legocachesoundmanager.h"
 #include "mxautolock.h"
 #include "mxomni.h"
@@ -46,7 +47,7 @@ MxResult LegoSoundManager::Create(MxU32 p_frequencyMS, MxBool p_createThread)
 		m_criticalSection.Enter();
 		locked = TRUE;
 
-		if (MxOmni::IsSound3D()) {
+		if (MxSoundManager::IsSound3D()) {
 			if (m_dsBuffer->QueryInterface(IID_IDirectSound3DListener, (LPVOID*) &m_listener) != DS_OK) {
 				goto done;
 			}
@@ -94,6 +95,7 @@ MxResult LegoSoundManager::Tickle()
 	MxSoundManager::Tickle();
 
 	AUTOLOCK(m_criticalSection);
+	Lego3DSoundUpdater::GetInstance()->Update();
 	return m_cacheSoundManager->Tickle();
 }
 
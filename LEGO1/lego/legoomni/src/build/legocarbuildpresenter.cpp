@@ -5,6 +5,7 @@
 #include "legoentity.h"
 #include "legogamestate.h"
 #include "legomain.h"
+#include "legonamehash.h"
 #include "legoutils.h"
 #include "legovideomanager.h"
 #include "legoworld.h"
@@ -19,6 +20,65 @@
 DECOMP_SIZE_ASSERT(LegoCarBuildAnimPresenter::UnknownListEntry, 0x0c)
 DECOMP_SIZE_ASSERT(LegoCarBuildAnimPresenter, 0x150)
 
+// Not part of the original game.
+// The names looked up by the presenter: the nodes of its animation, the ROIs
+// of its ROI map and its parts. Built once the animation is streamed.
+struct LegoCarBuildIndex {
+	// Finds the lowest part index from p_first on, as the linear searches do
+	MxBool FindPart(const LegoChar* p_name, MxS16 p_first, MxS16& p_index)
+	{
+		LegoNameHash<MxS16>::Bucket& bucket = m_parts.GetBucket(p_name);
+		MxBool found = FALSE;
+
+		for (MxU32 i = 0; i < bucket.size(); i++) {
+			MxS16 index = bucket[i].m_value;
+
+			if (index >= p_first && (!found || index < p_index) && !strcmpi(bucket[i].m_name, p_name)) {
+				p_index = index;
+				found = TRUE;
+			}
+		}
+
+		return found;
+	}
+
+	// Finds the node that comes first in the tree, as the tree search does
+	MxBool FindNode(const LegoChar* p_name, MxS32& p_ordinal)
+	{
+		LegoNameHash<MxS32>::Bucket& bucket = m_nodes.GetBucket(p_name);
+		MxBool found = FALSE;
+
+		for (MxU32 i = 0; i < bucket.size(); i++) {
+			MxS32 ordinal = bucket[i].m_value;
+
+			if ((!found || ordinal < p_ordinal) && !strcmpi(bucket[i].m_name, p_name)) {
+				p_ordinal = ordinal;
+				found = TRUE;
+			}
+		}
+
+		return found;
+	}
+
+	LegoNameHash<MxS32> m_nodes;          // positions in m_nodeList
+	vector<LegoAnimNodeData*> m_nodeList; // in the order of the tree search
+	LegoNameHash<LegoROI*> m_rois;
+	LegoNameHash<MxS16> m_parts;
+};
+
+struct LegoCarBuildIndexCompare {
+	MxBool operator()(LegoCarBuildAnimPresenter* const& p_a, LegoCarBuildAnimPresenter* const& p_b) const
+	{
+		return p_a < p_b;
+	}
+};
+
+typedef map<LegoCarBuildAnimPresenter*, LegoCarBuildIndex*, LegoCarBuildIndexCompare> LegoCarBuildIndexMap;
+
+// Not part of the original game.
+// The presenter has no room for its index in its layout.
+LegoCarBuildIndexMap g_carBuildIndexes;
+
 // FUNCTION: LEGO1 0x10078400
 // FUNCTION: BETA10 0x100707c0
 LegoCarBuildAnimPresenter::LegoCarBuildAnimPresenter()
@@ -51,6 +111,8 @@ LegoCarBuildAnimPresenter::~LegoCarBuildAnimPresenter()
 		delete[] m_parts;
 	}
 
+	DestroyIndex();
+
 	m_unk0xc8.GetRoot()->SetNumChildren(0);
 	*m_unk0xc8.GetRoot()->GetChildren() = NULL;
 
@@ -84,11 +146,23 @@ inline void LegoCarBuildAnimPresenter::Beta10Inline0x100733d0()
 			m_unk0x13c |= c_bit1;
 		}
 
-		if (m_placedPartCount < m_numberOfParts) {
+		if (m_placedPartCount < m_numberOfParts && m_roiMap != NULL) {
 
 			const LegoChar* wiredName = m_parts[m_placedPartCount].m_wiredName;
 
-			if (wiredName) {
+			LegoCarBuildIndex* index = GetIndex();
+
+			if (wiredName && index) {
+				LegoNameHash<LegoROI*>::Bucket& bucket = index->m_rois.GetBucket(wiredName);
+
+				for (MxU32 i = 0; i < bucket.size(); i++) {
+					// The search below starts at the second entry of the ROI map
+					if (bucket[i].m_value != m_roiMap[0] && stricmp(wiredName, bucket[i].m_name) == 0) {
+						bucket[i].m_value->SetVisibility(bvar5 ? TRUE : FALSE);
+					}
+				}
+			}
+			else if (wiredName) {
 				for (MxS32 i = 1; i <= m_roiMapSize; i++) {
 					LegoROI* roi = m_roiMap[i];
 
@@ -192,7 +266,9 @@ void LegoCarBuildAnimPresenter::StreamingTickle()
 	strcpy(m_mainSourceId, m_action->GetAtomId().GetInternal());
 	m_mainSourceId[strlen(m_mainSourceId) - 1] = 'M';
 
+	BuildIndex();
 	FUN_10079160();
+	IndexParts(GetIndex());
 
 	if (GameState()->GetCurrentAct() == LegoGameState::e_act2) {
 		m_placedPartCount = 10;
@@ -216,12 +292,12 @@ void LegoCarBuildAnimPresenter::StreamingTickle()
 		LegoChar* name = m_parts[i].m_wiredName;
 
 		if (name) {
-			for (MxS32 j = 0; j <= m_roiMapSize; j++) {
-				LegoROI* roi = m_roiMap[j];
+			LegoNameHash<LegoROI*>::Bucket& bucket = GetIndex()->m_rois.GetBucket(name);
 
-				if (roi && roi->GetName() && (strcmpi(name, roi->GetName()) == 0)) {
-					roi->FUN_100a9dd0();
-					roi->FUN_100a9350("lego red");
+			for (MxU32 j = 0; j < bucket.size(); j++) {
+				if (strcmpi(name, bucket[j].m_name) == 0) {
+					bucket[j].m_value->FUN_100a9dd0();
+					bucket[j].m_value->FUN_100a9350("lego red");
 				}
 			}
 		}
@@ -300,6 +376,9 @@ MxResult LegoCarBuildAnimPresenter::Serialize(LegoStorage* p_storage)
 			p_storage->ReadString(m_parts[i].m_wiredName);
 			p_storage->ReadS16(m_parts[i].m_objectId);
 		}
+
+		// The part names were overwritten
+		IndexParts(GetIndex());
 	}
 	else if (p_storage->IsWriteMode()) {
 		p_storage->WriteS16(m_placedPartCount);
@@ -329,13 +408,29 @@ void LegoCarBuildAnimPresenter::SwapNodesByName(LegoChar* p_name1, LegoChar* p_n
 	char buffer[40];
 
 	if (stricmp(p_name1, p_name2) != 0) {
+		LegoCarBuildIndex* index = GetIndex();
+		MxS32 ordinal1, ordinal2;
+		MxBool indexed = index && index->FindNode(p_name1, ordinal1) && index->FindNode(p_name2, ordinal2);
+
 		LegoAnimNodeData* node1 = FindNodeDataByName(m_anim->GetRoot(), p_name1);
 		LegoAnimNodeData* node2 = FindNodeDataByName(m_anim->GetRoot(), p_name2);
 
+		// The index holds the names of the nodes, so they leave it while renamed.
+		// Lookups pick the first node in the tree, so the order they return in does not matter.
+		if (indexed) {
+			index->m_nodes.Remove(node1->GetName(), ordinal1);
+			index->m_nodes.Remove(node2->GetName(), ordinal2);
+		}
+
 		strcpy(buffer, node1->GetName());
 		strcpy(node1->GetName(), node2->GetName());
 		strcpy(node2->GetName(), buffer);
 
+		if (indexed) {
+			index->m_nodes.Add(node1->GetName(), ordinal1);
+			index->m_nodes.Add(node2->GetName(), ordinal2);
+		}
+
 		LegoU16 val1 = node1->GetUnknown0x20();
 		node1->SetUnknown0x20(node2->GetUnknown0x20());
 		node2->SetUnknown0x20(val1);
@@ -482,6 +577,18 @@ void LegoCarBuildAnimPresenter::FUN_10079680(LegoChar* p_param)
 LegoAnimNodeData* LegoCarBuildAnimPresenter::FindNodeDataByName(LegoTreeNode* p_treeNode, const LegoChar* p_name)
 {
 	LegoAnimNodeData* data = NULL;
+	LegoCarBuildIndex* index = GetIndex();
+
+	// The index holds the nodes of the whole animation, in the order of this search
+	if (index && p_treeNode == m_anim->GetRoot()) {
+		MxS32 ordinal;
+
+		if (index->FindNode(p_name, ordinal)) {
+			data = index->m_nodeList[ordinal];
+		}
+
+		return data;
+	}
 
 	if (p_treeNode) {
 		data = (LegoAnimNodeData*) p_treeNode->GetData();
@@ -536,16 +643,30 @@ void LegoCarBuildAnimPresenter::FUN_10079790(const LegoChar* p_name)
 	LegoChar buffer[40];
 
 	if (strcmpi(m_parts[m_placedPartCount].m_name, p_name) != 0) {
-		for (i = m_placedPartCount + 1; i < m_numberOfParts; i++) {
-			if (stricmp(m_parts[i].m_name, p_name) == 0) {
-				break;
+		LegoCarBuildIndex* index = GetIndex();
+
+		if (!index || !index->FindPart(p_name, m_placedPartCount + 1, i)) {
+			for (i = m_placedPartCount + 1; i < m_numberOfParts; i++) {
+				if (stricmp(m_parts[i].m_name, p_name) == 0) {
+					break;
+				}
 			}
 		}
 
+		if (index) {
+			index->m_parts.Remove(m_parts[m_placedPartCount].m_name, m_placedPartCount);
+			index->m_parts.Remove(m_parts[i].m_name, i);
+		}
+
 		strcpy(buffer, m_parts[m_placedPartCount].m_name);
 		strcpy(m_parts[m_placedPartCount].m_name, m_parts[i].m_name);
 		strcpy(m_parts[i].m_name, buffer);
 		Swap(m_parts[m_placedPartCount].m_objectId, m_parts[i].m_objectId);
+
+		if (index) {
+			index->m_parts.Add(m_parts[m_placedPartCount].m_name, m_placedPartCount);
+			index->m_parts.Add(m_parts[i].m_name, i);
+		}
 	}
 	FUN_10079050(m_placedPartCount);
 	m_placedPartCount++;
@@ -654,6 +775,13 @@ MxBool LegoCarBuildAnimPresenter::FUN_10079c30(const LegoChar* p_name)
 // FUNCTION: BETA10 0x10072740
 MxBool LegoCarBuildAnimPresenter::PartIsPlaced(const LegoChar* p_name)
 {
+	LegoCarBuildIndex* index = GetIndex();
+	MxS16 partIndex;
+
+	if (index) {
+		return index->FindPart(p_name, 0, partIndex) && partIndex < m_placedPartCount;
+	}
+
 	for (MxS16 i = 0; i < m_placedPartCount; i++) {
 		if (strcmpi(p_name, m_parts[i].m_name) == 0) {
 			return TRUE;
@@ -681,6 +809,13 @@ MxBool LegoCarBuildAnimPresenter::StringDoesNotEndOnZero(const LegoChar* p_strin
 // FUNCTION: BETA10 0x1007284c
 const LegoChar* LegoCarBuildAnimPresenter::GetWiredNameByPartName(const LegoChar* p_name)
 {
+	LegoCarBuildIndex* index = GetIndex();
+	MxS16 partIndex;
+
+	if (index) {
+		return index->FindPart(p_name, 0, partIndex) ? m_parts[partIndex].m_wiredName : NULL;
+	}
+
 	for (MxS16 i = 0; i < m_numberOfParts; i++) {
 		if (strcmpi(p_name, m_parts[i].m_name) == 0) {
 			return m_parts[i].m_wiredName;
@@ -694,6 +829,17 @@ const LegoChar* LegoCarBuildAnimPresenter::GetWiredNameByPartName(const LegoChar
 // FUNCTION: BETA10 0x100728d1
 void LegoCarBuildAnimPresenter::SetPartObjectIdByName(const LegoChar* p_name, MxS16 p_objectId)
 {
+	LegoCarBuildIndex* index = GetIndex();
+	MxS16 partIndex;
+
+	if (index) {
+		if (index->FindPart(p_name, 0, partIndex)) {
+			m_parts[partIndex].m_objectId = p_objectId;
+		}
+
+		return;
+	}
+
 	for (MxS16 i = 0; i < m_numberOfParts; i++) {
 		if (strcmpi(p_name, m_parts[i].m_name) == 0) {
 			m_parts[i].m_objectId = p_objectId;
@@ -709,3 +855,83 @@ const BoundingSphere& LegoCarBuildAnimPresenter::FUN_10079e20()
 	LegoROI* roi = m_unk0x140->GetROI();
 	return roi->FindChildROI(m_parts[m_placedPartCount].m_wiredName, roi)->GetWorldBoundingSphere();
 }
+
+LegoCarBuildIndex* LegoCarBuildAnimPresenter::GetIndex()
+{
+	LegoCarBuildIndexMap::iterator it = g_carBuildIndexes.find(this);
+	return it != g_carBuildIndexes.end() ? (*it).second : NULL;
+}
+
+// Indexes the animation nodes and the ROI map. The parts are indexed once they are known.
+void LegoCarBuildAnimPresenter::BuildIndex()
+{
+	LegoCarBuildIndex* index = GetIndex();
+
+	if (index == NULL) {
+		index = new LegoCarBuildIndex;
+		g_carBuildIndexes[this] = index;
+	}
+
+	index->m_nodes.Clear();
+	index->m_nodeList.erase(index->m_nodeList.begin(), index->m_nodeList.end());
+	index->m_rois.Clear();
+	index->m_parts.Clear();
+
+	IndexNodes(index, m_anim->GetRoot());
+
+	if (m_roiMap != NULL) {
+		for (MxU32 i = 0; i <= m_roiMapSize; i++) {
+			LegoROI* roi = m_roiMap[i];
+
+			if (roi && roi->GetName()) {
+				index->m_rois.Add(roi->GetName(), roi);
+			}
+		}
+	}
+}
+
+// Numbers the nodes in the order FindNodeDataByName visits them, so duplicate names resolve the same way
+void LegoCarBuildAnimPresenter::IndexNodes(LegoCarBuildIndex* p_index, LegoTreeNode* p_treeNode)
+{
+	if (p_treeNode) {
+		LegoAnimNodeData* data = (LegoAnimNodeData*) p_treeNode->GetData();
+		p_index->m_nodes.Add(data->GetName(), p_index->m_nodeList.size());
+		p_index->m_nodeList.push_back(data);
+
+		for (MxS32 i = 0; i < p_treeNode->GetNumChildren(); i++) {
+			IndexNodes(p_index, p_treeNode->GetChildren()[i]);
+		}
+	}
+}
+
+void LegoCarBuildAnimPresenter::IndexParts(LegoCarBuildIndex* p_index)
+{
+	if (p_index == NULL || m_parts == NULL) {
+		return;
+	}
+
+	p_index->m_parts.Clear();
+
+	for (MxS16 i = 0; i < m_numberOfParts; i++) {
+		if (m_parts[i].m_name) {
+			p_index->m_parts.Add(m_parts[i].m_name, i);
+		}
+	}
+}
+
+// The index points into the animation and the ROI map, which LegoAnimPresenter::Destroy frees
+void LegoCarBuildAnimPresenter::Destroy()
+{
+	DestroyIndex();
+	LegoAnimPresenter::Destroy();
+}
+
+void LegoCarBuildAnimPresenter::DestroyIndex()
+{
+	LegoCarBuildIndexMap::iterator it = g_carBuildIndexes.find(this);
+
+	if (it != g_carBuildIndexes.end()) {
+		delete (*it).second;
+		g_carBuildIndexes.erase(it);
+	}
+}
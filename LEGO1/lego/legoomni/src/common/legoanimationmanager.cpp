@@ -10,6 +10,7 @@
 #include "legoendanimnotificationparam.h"
 #include "legoentitylist.h"
 #include "legoextraactor.h"
+#include "legoextraactorscheduler.h"
 #include "legogamestate.h"
 #include "legolocomotionanimpresenter.h"
 #include "legomain.h"
@@ -24,6 +25,7 @@
 #include "mxnotificationmanager.h"
 #include "mxticklemanager.h"
 #include "mxtimer.h"
+#include "mxtypeidtable.h"
 #include "mxutilities.h"
 #include "realtime/realtime.h"
 #include "viewmanager/viewmanager.h"
@@ -316,6 +318,9 @@ float g_unk0x100f7500 = 0.1f;
 // GLOBAL: LEGO1 0x100f7504
 MxS32 g_unk0x100f7504 = 0;
 
+// Not part of the original game.
+static MxTypeId g_typeLegoPathActor("LegoPathActor");
+
 // FUNCTION: LEGO1 0x1005eb50
 void LegoAnimationManager::configureLegoAnimationManager(MxS32 p_legoAnimationManagerConfig)
 {
@@ -1513,6 +1518,7 @@ MxResult LegoAnimationManager::Tickle()
 	float speed = actor->GetWorldSpeed();
 
 	FUN_10064b50(time);
+	ScheduleExtras(time);
 
 	if (!m_animRunning && time - m_unk0x404 > 10000 && speed < g_unk0x100f74b0[0][0] && speed > g_unk0x100f74b0[5][0]) {
 		LegoPathBoundary* boundary = actor->GetBoundary();
@@ -1687,7 +1693,7 @@ MxBool LegoAnimationManager::FUN_100623a0(AnimInfo& p_info)
 			LegoPathActor* actor = UserActor();
 
 			while (cursor.Next(entity)) {
-				if (entity != actor && entity->IsA("LegoPathActor")) {
+				if (entity != actor && MxIsA(entity, g_typeLegoPathActor)) {
 					LegoROI* roi = entity->GetROI();
 
 					if (roi->GetVisibility() && FUN_10062650(position, und, roi)) {
@@ -2851,6 +2857,28 @@ void LegoAnimationManager::FUN_10064b50(MxLong p_time)
 	}
 }
 
+// Hands the extras over to the scheduler, which decides how often each is animated
+void LegoAnimationManager::ScheduleExtras(MxLong p_time)
+{
+	LegoExtraActorScheduler* scheduler = LegoExtraActorScheduler::GetInstance();
+
+	if (!scheduler->IsClassifyDue(p_time)) {
+		return;
+	}
+
+	scheduler->BeginClassify(p_time);
+
+	for (MxS32 i = 0; i < (MxS32) sizeOfArray(m_extras); i++) {
+		LegoROI* roi = m_extras[i].m_roi;
+
+		if (roi != NULL) {
+			scheduler->Classify(CharacterManager()->GetExtraActor(roi->GetName()), roi);
+		}
+	}
+
+	scheduler->EndClassify();
+}
+
 // FUNCTION: LEGO1 0x10064ee0
 MxBool LegoAnimationManager::FUN_10064ee0(MxU32 p_objectId)
 {
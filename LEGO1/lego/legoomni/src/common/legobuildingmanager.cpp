@@ -3,9 +3,11 @@
 #include "3dmanager/lego3dmanager.h"
 #include "legocachesoundmanager.h"
 #include "legoentity.h"
+#include "legoentityindex.h"
 #include "legopathboundary.h"
 #include "legosoundmanager.h"
 #include "legovideomanager.h"
+#include "legowobblebatch.h"
 #include "legoworld.h"
 #include "misc.h"
 #include "misc/legostorage.h"
@@ -20,6 +22,14 @@ DECOMP_SIZE_ASSERT(LegoBuildingManager, 0x30)
 DECOMP_SIZE_ASSERT(LegoBuildingInfo, 0x2c)
 DECOMP_SIZE_ASSERT(LegoBuildingManager::AnimEntry, 0x14)
 
+// Not part of the original game.
+// The index of each building entity in g_buildingInfo
+LegoEntityIndex g_buildingIndex;
+
+// Not part of the original game.
+// Replaces m_entries, which only has room for five animations
+LegoWobbleBatch g_buildingWobbles;
+
 // GLOBAL: LEGO1 0x100f3410
 const char* g_buildingInfoVariants[5] = {
 	"haus1",
@@ -252,6 +262,9 @@ void LegoBuildingManager::Init()
 		g_buildingInfo[i] = g_buildingInfoInit[i];
 	}
 
+	g_buildingIndex.Clear();
+	g_buildingWobbles.Clear();
+
 	m_nextVariant = 0;
 	m_unk0x09 = FALSE;
 	m_numEntries = 0;
@@ -298,6 +311,7 @@ void LegoBuildingManager::CreateBuilding(MxS32 p_index, LegoWorld* p_world)
 	if (entity) {
 		entity->SetType(LegoEntity::e_building);
 		g_buildingInfo[p_index].m_entity = entity;
+		g_buildingIndex.Set(entity, p_index);
 		LegoROI* roi = entity->GetROI();
 		AdjustHeight(p_index);
 		MxMatrix mat = roi->GetLocal2World();
@@ -316,12 +330,10 @@ void LegoBuildingManager::Reset()
 		g_buildingInfo[i].m_entity = NULL;
 	}
 
+	g_buildingIndex.Clear();
 	m_unk0x09 = FALSE;
 
-	for (i = 0; i < m_numEntries; i++) {
-		delete m_entries[i];
-	}
-
+	g_buildingWobbles.Clear();
 	m_numEntries = 0;
 }
 
@@ -428,7 +440,11 @@ void LegoBuildingManager::AdjustHeight(MxS32 p_index)
 // FUNCTION: BETA10 0x10063fc9
 LegoBuildingInfo* LegoBuildingManager::GetInfo(LegoEntity* p_entity)
 {
-	MxS32 i;
+	MxS32 i = g_buildingIndex.Find(p_entity);
+
+	if (i >= 0 && g_buildingInfo[i].m_entity == p_entity) {
+		return &g_buildingInfo[i];
+	}
 
 	for (i = 0; i < sizeOfArray(g_buildingInfo); i++) {
 		if (g_buildingInfo[i].m_entity == p_entity) {
@@ -670,23 +686,21 @@ void LegoBuildingManager::ScheduleAnimation(LegoEntity* p_entity, MxLong p_lengt
 		m_sound->SetDistance(35, 60);
 	}
 
+	MxLong time = Timer()->GetTime();
+	time += p_length;
+
+	float height = p_entity->GetROI()->GetWorldPosition()[1];
+
+	if (g_buildingWobbles.Add(p_entity, time + 1000, height, p_haveSound == FALSE) != SUCCESS) {
+		return;
+	}
+
 	if (m_numEntries == 0) {
 		m_unk0x28 = p_unk0x28;
 		TickleManager()->RegisterClient(this, 50);
 	}
 
-	AnimEntry* entry = m_entries[m_numEntries] = new AnimEntry;
-	m_numEntries++;
-
-	entry->m_entity = p_entity;
-	entry->m_roi = p_entity->GetROI();
-
-	MxLong time = Timer()->GetTime();
-	time += p_length;
-	entry->m_time = time + 1000;
-
-	entry->m_unk0x0c = entry->m_roi->GetWorldPosition()[1];
-	entry->m_muted = p_haveSound == FALSE;
+	m_numEntries = g_buildingWobbles.GetCount();
 	FUN_100307b0(p_entity, -2);
 }
 
@@ -696,74 +710,62 @@ MxResult LegoBuildingManager::Tickle()
 	MxLong time = Timer()->GetTime();
 
 	if (m_numEntries != 0) {
-		for (MxS32 i = 0; i < m_numEntries; i++) {
-			AnimEntry** ppEntry = &m_entries[i];
-			AnimEntry* entry = *ppEntry;
+		MxS32 i;
 
-			if (m_world != CurrentWorld() || !entry->m_entity) {
-				delete entry;
-				m_numEntries--;
-
-				if (m_numEntries != i) {
-					m_entries[i] = m_entries[m_numEntries];
-					m_entries[m_numEntries] = NULL;
-				}
+		if (m_world != CurrentWorld()) {
+			g_buildingWobbles.Clear();
+			m_numEntries = 0;
+			return SUCCESS;
+		}
 
-				break;
-			}
+		float bounce[LegoWobbleBatch::c_maxEntries];
 
-			if (entry->m_time - time > 1000) {
-				break;
-			}
+		g_buildingWobbles.Advance(time);
+		g_buildingWobbles.ComputeWave(10, 0.4f, bounce);
 
-			if (!entry->m_muted) {
-				entry->m_muted = TRUE;
-				SoundManager()->GetCacheSoundManager()->Play(m_sound, entry->m_roi->GetName(), FALSE);
+		for (i = 0; i < g_buildingWobbles.GetCount(); i++) {
+			if (!g_buildingWobbles.IsStarted(i)) {
+				continue;
 			}
 
-			MxMatrix local48;
-			MxMatrix locald8;
-
-			MxMatrix local120(entry->m_roi->GetLocal2World());
-			Mx3DPointFloat local134(local120[3]);
+			LegoROI* roi = g_buildingWobbles.GetROI(i);
 
-			ZEROVEC3(local120[3]);
-
-			locald8.SetIdentity();
-			local48 = local120;
+			if (!g_buildingWobbles.GetMuted(i)) {
+				g_buildingWobbles.GetMuted(i) = TRUE;
+				SoundManager()->GetCacheSoundManager()->Play(m_sound, roi->GetName(), FALSE);
+			}
 
-			local134[1] = sin(((entry->m_time - time) * 10) * 0.0062831999f) * 0.4 + (entry->m_unk0x0c -= 0.05);
-			SET3(local120[3], local134);
+			MxMatrix mat(roi->GetLocal2World());
+			mat[3][1] = bounce[i] + (g_buildingWobbles.GetHeight(i) -= 0.05);
 
-			entry->m_roi->UpdateTransformationRelativeToParent(local120);
-			VideoManager()->Get3DManager()->Moved(*entry->m_roi);
+			roi->UpdateTransformationRelativeToParent(mat);
+			VideoManager()->Get3DManager()->Moved(*roi);
+		}
 
-			if (entry->m_time < time) {
-				LegoBuildingInfo* info = GetInfo(entry->m_entity);
+		// Backwards, since a removed entry is replaced by the last one
+		for (i = g_buildingWobbles.GetCount() - 1; i >= 0; i--) {
+			if (g_buildingWobbles.IsFinished(i)) {
+				LegoROI* roi = g_buildingWobbles.GetROI(i);
+				LegoBuildingInfo* info = GetInfo(g_buildingWobbles.GetEntity(i));
 
 				if (info->m_unk0x11 && !m_unk0x28) {
 					MxS32 index = info - g_buildingInfo;
 					AdjustHeight(index);
-					MxMatrix mat = entry->m_roi->GetLocal2World();
+					MxMatrix mat = roi->GetLocal2World();
 					mat[3][1] = g_buildingInfo[index].m_unk0x14;
-					entry->m_roi->UpdateTransformationRelativeToParent(mat);
-					VideoManager()->Get3DManager()->Moved(*entry->m_roi);
+					roi->UpdateTransformationRelativeToParent(mat);
+					VideoManager()->Get3DManager()->Moved(*roi);
 				}
 				else {
 					info->m_unk0x11 = 0;
-					entry->m_roi->SetVisibility(FALSE);
+					roi->SetVisibility(FALSE);
 				}
 
-				delete entry;
-				m_numEntries--;
-
-				if (m_numEntries != i) {
-					i--;
-					*ppEntry = m_entries[m_numEntries];
-					m_entries[m_numEntries] = NULL;
-				}
+				g_buildingWobbles.Remove(i);
 			}
 		}
+
+		m_numEntries = g_buildingWobbles.GetCount();
 	}
 	else {
 		TickleManager()->UnregisterClient(this);
@@ -518,20 +518,29 @@ LegoROI* LegoCharacterManager::CreateActorROI(const char* p_key)
 			parentName = g_actorLODs[i + 1].m_parentName;
 		}
 
-		ViewLODList* lodList = lodManager->Lookup(parentName);
-		MxS32 lodSize = lodList->Size();
-		sprintf(lodName, "%s%d", p_key, i);
-		ViewLODList* dupLodList = lodManager->Create(lodName, lodSize);
+		MxBool customized = g_actorLODs[i + 1].m_flags & (LegoActorLOD::c_flag1 | LegoActorLOD::c_flag2) ||
+							(i == 0 && part.m_unk0x00[part.m_unk0x08] == 0);
+
+		// Actors wearing the same part in the same color or texture share a single LOD list.
+		// The list is only duplicated once an actor's appearance changes, see UnshareLODList.
+		sprintf(lodName, "%s:%s", parentName, customized ? part.m_unk0x10[part.m_unk0x0c[part.m_unk0x14]] : "");
+		ViewLODList* lodList = lodManager->Lookup(lodName);
+		MxBool shared = lodList != NULL;
+
+		if (!shared) {
+			ViewLODList* srcLodList = lodManager->Lookup(parentName);
+			MxS32 lodSize = srcLodList->Size();
+			lodList = lodManager->Create(lodName, lodSize);
+
+			for (MxS32 j = 0; j < lodSize; j++) {
+				LegoLOD* lod = (LegoLOD*) (*srcLodList)[j];
+				LegoLOD* clone = lod->Clone(renderer);
+				lodList->PushBack(clone);
+			}
 
-		for (MxS32 j = 0; j < lodSize; j++) {
-			LegoLOD* lod = (LegoLOD*) (*lodList)[j];
-			LegoLOD* clone = lod->Clone(renderer);
-			dupLodList->PushBack(clone);
+			srcLodList->Release();
 		}
 
-		lodList->Release();
-		lodList = dupLodList;
-
 		LegoROI* childROI = new LegoROI(renderer, lodList);
 		lodList->Release();
 
@@ -562,7 +571,10 @@ LegoROI* LegoCharacterManager::CreateActorROI(const char* p_key)
 		);
 		childROI->WrappedSetLocalTransform(mat);
 
-		if (g_actorLODs[i + 1].m_flags & LegoActorLOD::c_flag1 && (i != 0 || part.m_unk0x00[part.m_unk0x08] != 0)) {
+		if (shared) {
+			// Color or texture has already been applied to the shared LODs
+		}
+		else if (g_actorLODs[i + 1].m_flags & LegoActorLOD::c_flag1 && (i != 0 || part.m_unk0x00[part.m_unk0x08] != 0)) {
 
 			LegoTextureInfo* textureInfo = textureContainer->Get(part.m_unk0x10[part.m_unk0x0c[part.m_unk0x14]]);
 
@@ -797,10 +809,46 @@ MxBool LegoCharacterManager::SwitchColor(LegoROI* p_roi, LegoROI* p_targetROI)
 
 	LegoFloat red, green, blue, alpha;
 	LegoROI::FUN_100a9bf0(part.m_unk0x10[part.m_unk0x0c[part.m_unk0x14]], red, green, blue, alpha);
+	UnshareLODList(p_targetROI);
 	p_targetROI->FUN_100a9170(red, green, blue, alpha);
 	return TRUE;
 }
 
+// Replaces the LOD list of p_roi with a private copy, so that its color
+// can be changed without affecting other actors sharing the same part.
+// Shared lists are stored under "part:appearance", see CreateActorROI. A list
+// stored under another name and only used by p_roi is already private.
+void LegoCharacterManager::UnshareLODList(LegoROI* p_roi)
+{
+	char lodName[256];
+
+	const ViewLODList* lodList = (const ViewLODList*) p_roi->GetLODs();
+	const char* name = GetViewLODListManager()->GetName(lodList);
+
+	if (lodList == NULL || (lodList->GetRefCount() == 1 && name != NULL && strchr(name, ':') == NULL)) {
+		return;
+	}
+
+	MxS32 lodSize = p_roi->GetLODCount();
+	sprintf(lodName, "%s%d", p_roi->GetName(), g_unk0x100fc4ec++);
+	ViewLODList* dupLodList = GetViewLODListManager()->Create(lodName, lodSize);
+
+	Tgl::Renderer* renderer = VideoManager()->GetRenderer();
+
+	for (MxS32 i = 0; i < lodSize; i++) {
+		LegoLOD* lod = (LegoLOD*) p_roi->GetLOD(i);
+		LegoLOD* clone = lod->Clone(renderer);
+		dupLodList->PushBack(clone);
+	}
+
+	if (p_roi->GetUnknown0xe0() >= 0) {
+		VideoManager()->Get3DManager()->GetLego3DView()->GetViewManager()->RemoveROIDetailFromScene(p_roi);
+	}
+
+	p_roi->SetLODList(dupLodList);
+	dupLodList->Release();
+}
+
 // FUNCTION: LEGO1 0x10084ec0
 MxBool LegoCharacterManager::SwitchVariant(LegoROI* p_roi)
 {
@@ -0,0 +1,193 @@
+#include "legoextraactorscheduler.h"
+
+#include "legopathactor.h"
+#include "legovideomanager.h"
+#include "misc.h"
+#include "mxmisc.h"
+#include "mxtimer.h"
+#include "roi/legoroi.h"
+#include "viewmanager/viewmanager.h"
+
+DECOMP_SIZE_ASSERT(LegoExtraActorScheduler, 0x2d0)
+
+LegoExtraActorScheduler::LegoExtraActorScheduler()
+{
+	m_numActors = 0;
+	m_classifyTime = 0;
+	m_hasPov = FALSE;
+	m_crowdBudget = 12;
+	m_nearDistance = 30.0f;
+	m_farDistance = 80.0f;
+	m_intervals[e_near] = 0;
+	m_intervals[e_mid] = 50;
+	m_intervals[e_far] = 200;
+	ResetStatistics();
+}
+
+LegoExtraActorScheduler* LegoExtraActorScheduler::GetInstance()
+{
+	static LegoExtraActorScheduler g_instance;
+	return &g_instance;
+}
+
+void LegoExtraActorScheduler::BeginClassify(MxLong p_time)
+{
+	m_classifyTime = p_time;
+
+	for (MxS32 i = 0; i < m_numActors; i++) {
+		m_flags[i] = 0;
+	}
+
+	LegoROI* pov = VideoManager()->GetViewROI();
+	m_hasPov = pov != NULL;
+
+	if (m_hasPov) {
+		const float* position = pov->GetWorldPosition();
+		m_povPosition[0] = position[0];
+		m_povPosition[1] = position[1];
+		m_povPosition[2] = position[2];
+	}
+}
+
+void LegoExtraActorScheduler::Classify(LegoPathActor* p_actor, LegoROI* p_roi)
+{
+	if (p_actor == NULL || p_roi == NULL) {
+		return;
+	}
+
+	MxS32 i = Find(p_actor);
+
+	if (i < 0) {
+		if (m_numActors == c_maxActors) {
+			return;
+		}
+
+		// New actors are animated on the next tick
+		i = m_numActors++;
+		m_actors[i] = p_actor;
+		m_nextTimes[i] = 0.0f;
+	}
+
+	m_flags[i] = c_seen;
+	m_distances[i] = 0.0f;
+
+	if (m_hasPov) {
+		const float* position = p_roi->GetWorldPosition();
+		float dx = position[0] - m_povPosition[0];
+		float dy = position[1] - m_povPosition[1];
+		float dz = position[2] - m_povPosition[2];
+		m_distances[i] = dx * dx + dy * dy + dz * dz;
+	}
+
+	ViewManager* viewManager = GetViewManager();
+
+	if (p_roi->GetVisibility() &&
+		(viewManager == NULL || viewManager->IsBoundingBoxInFrustum(p_roi->GetWorldBoundingBox()))) {
+		m_flags[i] |= c_inFrustum;
+	}
+}
+
+void LegoExtraActorScheduler::EndClassify()
+{
+	MxS32 i;
+
+	// Drop the actors that are gone, moving the last one into the gap
+	for (i = m_numActors - 1; i >= 0; i--) {
+		if (!(m_flags[i] & c_seen)) {
+			m_numActors--;
+			m_actors[i] = m_actors[m_numActors];
+			m_distances[i] = m_distances[m_numActors];
+			m_nextTimes[i] = m_nextTimes[m_numActors];
+			m_flags[i] = m_flags[m_numActors];
+		}
+	}
+
+	float nearSquared = m_nearDistance * m_nearDistance;
+	float farSquared = m_farDistance * m_farDistance;
+
+	for (i = 0; i < e_numTiers; i++) {
+		m_numTierActors[i] = 0;
+	}
+
+	for (i = 0; i < m_numActors; i++) {
+		MxBool inFrustum = m_flags[i] & c_inFrustum;
+		float distance = m_distances[i];
+
+		if (inFrustum && distance < nearSquared) {
+			// Only the closest actors within the crowd budget are near
+			MxS32 closer = 0;
+
+			for (MxS32 j = 0; j < m_numActors; j++) {
+				if ((m_flags[j] & c_inFrustum) &&
+					(m_distances[j] < distance || (m_distances[j] == distance && j < i))) {
+					closer++;
+				}
+			}
+
+			m_tiers[i] = closer < m_crowdBudget ? e_near : e_mid;
+		}
+		else if ((inFrustum && distance < farSquared) || distance < nearSquared) {
+			m_tiers[i] = e_mid;
+		}
+		else {
+			m_tiers[i] = e_far;
+		}
+
+		if (m_tiers[i] == e_near) {
+			m_nextTimes[i] = 0.0f;
+		}
+
+		m_numTierActors[m_tiers[i]]++;
+	}
+}
+
+// Called by the path controllers in place of LegoPathActor::Animate
+void LegoExtraActorScheduler::Animate(LegoPathActor* p_actor, float p_time)
+{
+	MxS32 i = IsCurrent(p_time) ? Find(p_actor) : -1;
+
+	if (i < 0) {
+		p_actor->Animate(p_time);
+		return;
+	}
+
+	MxU8 tier = m_tiers[i];
+
+	if (p_time < m_nextTimes[i]) {
+		m_numSkipped[tier]++;
+		return;
+	}
+
+	m_nextTimes[i] = p_time + m_intervals[tier];
+	m_numAnimated[tier]++;
+
+	m_timers[tier].Start();
+	p_actor->Animate(p_time);
+	m_timers[tier].Stop();
+}
+
+MxBool LegoExtraActorScheduler::HasFullCollision(LegoPathActor* p_actor)
+{
+	MxS32 i = Find(p_actor);
+	return i < 0 || m_tiers[i] == e_near || !IsCurrent(Timer()->GetTime());
+}
+
+void LegoExtraActorScheduler::ResetStatistics()
+{
+	for (MxS32 i = 0; i < e_numTiers; i++) {
+		m_timers[i].Reset();
+		m_numAnimated[i] = 0;
+		m_numSkipped[i] = 0;
+	}
+}
+
+MxS32 LegoExtraActorScheduler::Find(LegoPathActor* p_actor)
+{
+	for (MxS32 i = 0; i < m_numActors; i++) {
+		if (m_actors[i] == p_actor) {
+			return i;
+		}
+	}
+
+	return -1;
+}
@@ -36,11 +36,13 @@
 #include "legomain.h"
 #include "legonavcontroller.h"
 #include "legoplantmanager.h"
+#include "legosavewriter.h"
 #include "legostate.h"
 #include "legoutils.h"
 #include "legovideomanager.h"
 #include "legoworld.h"
 #include "misc.h"
+#include "misc/legostorage.h"
 #include "mxbackgroundaudiomanager.h"
 #include "mxmisc.h"
 #include "mxnotificationmanager.h"
@@ -141,6 +143,9 @@ const char* g_strEnable = "enable";
 // STRING: LEGO1 0x100f3bf4
 const char* g_strDisable = "disable";
 
+// Not part of the original game.
+LegoSaveWriter* LegoGameState::g_saveWriter = NULL;
+
 // FUNCTION: LEGO1 0x10039550
 LegoGameState::LegoGameState()
 {
@@ -171,6 +176,10 @@ LegoGameState::LegoGameState()
 
 	VariableTable()->SetVariable("lightposition", "2");
 	SerializeScoreHistory(1);
+
+	// Saves are still written, just without the worker thread, if it can't be started
+	g_saveWriter = new LegoSaveWriter;
+	g_saveWriter->Create();
 }
 
 // FUNCTION: LEGO1 0x10039720
@@ -189,6 +198,9 @@ LegoGameState::~LegoGameState()
 		delete[] m_stateArray;
 	}
 
+	delete g_saveWriter;
+	g_saveWriter = NULL;
+
 	delete[] m_savePath;
 }
 
@@ -262,7 +274,7 @@ MxResult LegoGameState::Save(MxULong p_slot)
 	}
 
 	MxResult result = FAILURE;
-	LegoFile storage;
+	LegoMemoryBuffer storage(LegoStorage::c_write);
 	MxVariableTable* variableTable = VariableTable();
 	MxS16 count = 0;
 	MxU32 i;
@@ -272,10 +284,7 @@ MxResult LegoGameState::Save(MxULong p_slot)
 	MxString savePath;
 	GetFileSavePath(&savePath, p_slot);
 
-	if (storage.Open(savePath.GetData(), LegoFile::c_write) == FAILURE) {
-		goto done;
-	}
-
+	// The save is serialized into memory and written to disk by g_saveWriter
 	storage.WriteS32(0x1000c);
 	storage.WriteS16(m_unk0x24);
 	storage.WriteU16(m_currentAct);
@@ -315,6 +324,11 @@ MxResult LegoGameState::Save(MxULong p_slot)
 
 	area = m_unk0x42c;
 	storage.WriteU16(area);
+
+	if (g_saveWriter->Submit(savePath.GetData(), storage) != SUCCESS) {
+		result = FAILURE;
+	}
+
 	SerializeScoreHistory(2);
 	m_isDirty = FALSE;
 
@@ -356,6 +370,8 @@ MxResult LegoGameState::Load(MxULong p_slot)
 	MxString savePath;
 	GetFileSavePath(&savePath, p_slot);
 
+	g_saveWriter->Flush();
+
 	if (storage.Open(savePath.GetData(), LegoFile::c_read) == FAILURE) {
 		goto done;
 	}
@@ -600,6 +616,9 @@ MxResult LegoGameState::AddPlayer(Username& p_player)
 {
 	MxString from, to;
 
+	g_saveWriter->Flush();
+	g_saveWriter->ForgetSnapshots();
+
 	if (m_playerCount == 9) {
 		GetFileSavePath(&from, 8);
 		DeleteFile(from.GetData());
@@ -630,6 +649,9 @@ void LegoGameState::SwitchPlayer(MxS16 p_playerId)
 	if (p_playerId > 0) {
 		MxString from, temp, to;
 
+		g_saveWriter->Flush();
+		g_saveWriter->ForgetSnapshots();
+
 		GetFileSavePath(&from, p_playerId);
 		GetFileSavePath(&temp, 36);
 
@@ -3,8 +3,10 @@
 #include "3dmanager/lego3dmanager.h"
 #include "legocharactermanager.h"
 #include "legoentity.h"
+#include "legoentityindex.h"
 #include "legoplants.h"
 #include "legovideomanager.h"
+#include "legowobblebatch.h"
 #include "legoworld.h"
 #include "misc.h"
 #include "misc/legostorage.h"
@@ -22,6 +24,14 @@
 DECOMP_SIZE_ASSERT(LegoPlantManager, 0x2c)
 DECOMP_SIZE_ASSERT(LegoPlantManager::AnimEntry, 0x0c)
 
+// Not part of the original game.
+// The index of each plant entity in g_plantInfo
+LegoEntityIndex g_plantIndex;
+
+// Not part of the original game.
+// Replaces m_entries, which only has room for five animations
+LegoWobbleBatch g_plantWobbles;
+
 // GLOBAL: LEGO1 0x100f1660
 const char* g_plantLodNames[4][5] = {
 	{"flwrwht", "flwrblk", "flwryel", "flwrred", "flwrgrn"},
@@ -82,6 +92,9 @@ void LegoPlantManager::Init()
 		g_plantInfo[i] = g_plantInfoInit[i];
 	}
 
+	g_plantIndex.Clear();
+	g_plantWobbles.Clear();
+
 	m_worldId = LegoOmni::e_undefined;
 	m_unk0x0c = 0;
 	m_numEntries = 0;
@@ -108,10 +121,7 @@ void LegoPlantManager::Reset(LegoOmni::World p_worldId)
 	MxU32 i;
 	DeleteObjects(g_sndAnimScript, SndanimScript::c_AnimC1, SndanimScript::c_AnimBld18);
 
-	for (i = 0; i < m_numEntries; i++) {
-		delete m_entries[i];
-	}
-
+	g_plantWobbles.Clear();
 	m_numEntries = 0;
 
 	for (i = 0; i < sizeOfArray(g_plantInfo); i++) {
@@ -237,6 +247,7 @@ LegoEntity* LegoPlantManager::CreatePlant(MxS32 p_index, LegoWorld* p_world, Leg
 				);
 				entity->SetType(LegoEntity::e_plant);
 				g_plantInfo[p_index].m_entity = entity;
+				g_plantIndex.Set(entity, p_index);
 			}
 			else {
 				entity = g_plantInfo[p_index].m_entity;
@@ -256,6 +267,7 @@ void LegoPlantManager::RemovePlant(MxS32 p_index, LegoOmni::World p_worldId)
 
 		if (g_plantInfo[p_index].m_worlds & world && g_plantInfo[p_index].m_entity != NULL) {
 			CharacterManager()->ReleaseAutoROI(g_plantInfo[p_index].m_entity->GetROI());
+			g_plantIndex.Remove(g_plantInfo[p_index].m_entity);
 			g_plantInfo[p_index].m_entity = NULL;
 		}
 	}
@@ -360,7 +372,11 @@ MxS32 LegoPlantManager::GetNumPlants()
 // FUNCTION: BETA10 0x100c5c95
 LegoPlantInfo* LegoPlantManager::GetInfo(LegoEntity* p_entity)
 {
-	MxS32 i;
+	MxS32 i = g_plantIndex.Find(p_entity);
+
+	if (i >= 0 && g_plantInfo[i].m_entity == p_entity) {
+		return &g_plantInfo[i];
+	}
 
 	for (i = 0; i < sizeOfArray(g_plantInfo); i++) {
 		if (g_plantInfo[i].m_entity == p_entity) {
@@ -609,20 +625,18 @@ void LegoPlantManager::ScheduleAnimation(LegoEntity* p_entity, MxLong p_length)
 {
 	m_world = CurrentWorld();
 
+	MxLong time = Timer()->GetTime();
+	time += p_length;
+
+	if (g_plantWobbles.Add(p_entity, time + 1000, 0.0f, TRUE) != SUCCESS) {
+		return;
+	}
+
 	if (m_numEntries == 0) {
 		TickleManager()->RegisterClient(this, 50);
 	}
 
-	AnimEntry* entry = m_entries[m_numEntries] = new AnimEntry;
-	m_numEntries++;
-
-	entry->m_entity = p_entity;
-	entry->m_roi = p_entity->GetROI();
-
-	MxLong time = Timer()->GetTime();
-	time += p_length;
-	entry->m_time = time + 1000;
-
+	m_numEntries = g_plantWobbles.GetCount();
 	FUN_100271b0(p_entity, -1);
 }
 
@@ -632,64 +646,60 @@ MxResult LegoPlantManager::Tickle()
 	MxLong time = Timer()->GetTime();
 
 	if (m_numEntries != 0) {
-		for (MxS32 i = 0; i < m_numEntries; i++) {
-			AnimEntry** ppEntry = &m_entries[i];
-			AnimEntry* entry = *ppEntry;
+		MxS32 i;
 
-			if (m_world != CurrentWorld() || !entry->m_entity) {
-				delete entry;
-				m_numEntries--;
+		if (m_world != CurrentWorld()) {
+			g_plantWobbles.Clear();
+			m_numEntries = 0;
+			return SUCCESS;
+		}
 
-				if (m_numEntries != i) {
-					m_entries[i] = m_entries[m_numEntries];
-					m_entries[m_numEntries] = NULL;
-				}
+		float shearX[LegoWobbleBatch::c_maxEntries];
+		float shearZ[LegoWobbleBatch::c_maxEntries];
 
-				break;
-			}
+		g_plantWobbles.Advance(time);
+		g_plantWobbles.ComputeWave(2, 0.2f, shearX);
+		g_plantWobbles.ComputeWave(4, 0.2f, shearZ);
 
-			if (entry->m_time - time > 1000) {
-				break;
+		for (i = 0; i < g_plantWobbles.GetCount(); i++) {
+			if (!g_plantWobbles.IsStarted(i)) {
+				continue;
 			}
 
-			MxMatrix local90;
-			MxMatrix local48;
-
-			MxMatrix locald8(entry->m_roi->GetLocal2World());
-			Mx3DPointFloat localec(locald8[3]);
+			LegoROI* roi = g_plantWobbles.GetROI(i);
+			MxMatrix mat(roi->GetLocal2World());
+			Mx3DPointFloat position(mat[3]);
 
-			ZEROVEC3(locald8[3]);
+			ZEROVEC3(mat[3]);
 
-			locald8[1][0] = sin(((entry->m_time - time) * 2) * 0.0062832f) * 0.2;
-			locald8[1][2] = sin(((entry->m_time - time) * 4) * 0.0062832f) * 0.2;
-			locald8.Scale(1.03f, 0.95f, 1.03f);
+			mat[1][0] = shearX[i];
+			mat[1][2] = shearZ[i];
+			mat.Scale(1.03f, 0.95f, 1.03f);
 
-			SET3(locald8[3], localec);
+			SET3(mat[3], position);
 
-			entry->m_roi->FUN_100a58f0(locald8);
-			entry->m_roi->VTable0x14();
+			roi->FUN_100a58f0(mat);
+			roi->VTable0x14();
+		}
 
-			if (entry->m_time < time) {
-				LegoPlantInfo* info = GetInfo(entry->m_entity);
+		// Backwards, since a removed entry is replaced by the last one
+		for (i = g_plantWobbles.GetCount() - 1; i >= 0; i--) {
+			if (g_plantWobbles.IsFinished(i)) {
+				LegoPlantInfo* info = GetInfo(g_plantWobbles.GetEntity(i));
 
 				if (info->m_unk0x16 == 0) {
-					entry->m_roi->SetVisibility(FALSE);
+					g_plantWobbles.GetROI(i)->SetVisibility(FALSE);
 				}
 				else {
 					FUN_10026860(info - g_plantInfo);
 					info->m_entity->SetLocation(info->m_position, info->m_direction, info->m_up, FALSE);
 				}
 
-				delete entry;
-				m_numEntries--;
-
-				if (m_numEntries != i) {
-					i--;
-					*ppEntry = m_entries[m_numEntries];
-					m_entries[m_numEntries] = NULL;
-				}
+				g_plantWobbles.Remove(i);
 			}
 		}
+
+		m_numEntries = g_plantWobbles.GetCount();
 	}
 	else {
 		TickleManager()->UnregisterClient(this);
@@ -0,0 +1,270 @@
+#include "legosavewriter.h"
+
+#include "misc/legostorage.h"
+#include "mxautolock.h"
+
+#include <windows.h>
+
+DECOMP_SIZE_ASSERT(LegoSaveWriterThread, 0x20)
+DECOMP_SIZE_ASSERT(LegoSaveWriter::File, 0x18)
+DECOMP_SIZE_ASSERT(LegoSaveWriter, 0x84)
+
+MxResult LegoSaveWriterThread::Run()
+{
+	if (m_writer) {
+		m_writer->WriteFiles();
+	}
+
+	return MxThread::Run();
+}
+
+MxResult LegoSaveWriterThread::StartWithWriter(LegoSaveWriter* p_writer)
+{
+	m_writer = p_writer;
+	return Start(0x1000, 0);
+}
+
+LegoSaveWriter::LegoSaveWriter()
+{
+	m_numWriting = 0;
+	m_running = FALSE;
+	m_numWritten = 0;
+	m_numSkipped = 0;
+	m_numFailed = 0;
+	m_bytesWritten = 0;
+}
+
+LegoSaveWriter::~LegoSaveWriter()
+{
+	Destroy();
+}
+
+// Without the worker thread, saves are written right away by Submit
+MxResult LegoSaveWriter::Create()
+{
+	if (m_workSemaphore.Init(0, 100) != SUCCESS || m_doneSemaphore.Init(0, 100) != SUCCESS) {
+		return FAILURE;
+	}
+
+	m_running = TRUE;
+
+	if (m_thread.StartWithWriter(this) != SUCCESS) {
+		m_running = FALSE;
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+void LegoSaveWriter::Destroy()
+{
+	if (m_running) {
+		Flush();
+
+		m_running = FALSE;
+		m_workSemaphore.Release(1);
+		m_thread.Terminate();
+	}
+
+	DeleteFiles(m_pending);
+	DeleteFiles(m_snapshots);
+}
+
+// Takes over the contents of p_storage
+MxResult LegoSaveWriter::Submit(const char* p_path, LegoMemoryBuffer& p_storage)
+{
+	m_lock.Enter();
+
+	File* snapshot = FindSnapshot(p_path);
+
+	if (snapshot != NULL && snapshot->m_size == p_storage.GetSize() &&
+		memcmp(snapshot->m_data, p_storage.GetBuffer(), snapshot->m_size) == 0) {
+		m_numSkipped++;
+		m_lock.Leave();
+		return SUCCESS;
+	}
+
+	if (snapshot == NULL) {
+		snapshot = new File;
+		snapshot->m_path = p_path;
+		snapshot->m_data = NULL;
+		m_snapshots.push_back(snapshot);
+	}
+
+	delete[] snapshot->m_data;
+	snapshot->m_size = p_storage.GetSize();
+	snapshot->m_data = new MxU8[snapshot->m_size];
+	memcpy(snapshot->m_data, p_storage.GetBuffer(), snapshot->m_size);
+
+	File* file = new File;
+	file->m_path = p_path;
+	file->m_size = p_storage.GetSize();
+	file->m_data = p_storage.Detach();
+
+	if (!m_running) {
+		m_lock.Leave();
+
+		MxResult result = WriteFile(file);
+
+		m_lock.Enter();
+
+		if (result == SUCCESS) {
+			m_numWritten++;
+			m_bytesWritten += file->m_size;
+		}
+		else {
+			m_numFailed++;
+			RemoveSnapshot(file->m_path.GetData());
+		}
+
+		m_lock.Leave();
+
+		delete[] file->m_data;
+		delete file;
+		return result;
+	}
+
+	// A save of the same file that has not been started is replaced
+	for (FileVector::iterator it = m_pending.begin(); it != m_pending.end(); it++) {
+		if (!strcmpi((*it)->m_path.GetData(), p_path)) {
+			delete[] (*it)->m_data;
+			delete *it;
+			m_pending.erase(it);
+			break;
+		}
+	}
+
+	m_pending.push_back(file);
+	m_lock.Leave();
+
+	m_workSemaphore.Release(1);
+	return SUCCESS;
+}
+
+// Waits until every submitted save is on disk
+void LegoSaveWriter::Flush()
+{
+	m_lock.Enter();
+
+	while (m_running && (!m_pending.empty() || m_numWriting != 0)) {
+		m_lock.Leave();
+		m_doneSemaphore.Wait(INFINITE);
+		m_lock.Enter();
+	}
+
+	m_lock.Leave();
+}
+
+// Called when save files are moved or deleted, so the snapshots may no longer
+// match the files on disk
+void LegoSaveWriter::ForgetSnapshots()
+{
+	AUTOLOCK(m_lock);
+	DeleteFiles(m_snapshots);
+}
+
+void LegoSaveWriter::WriteFiles()
+{
+	while (m_running) {
+		m_workSemaphore.Wait(INFINITE);
+
+		m_lock.Enter();
+
+		if (m_pending.empty()) {
+			m_lock.Leave();
+			continue;
+		}
+
+		File* file = m_pending.front();
+		m_pending.erase(m_pending.begin());
+		m_numWriting++;
+		m_lock.Leave();
+
+		MxResult result = WriteFile(file);
+
+		m_lock.Enter();
+		m_numWriting--;
+
+		if (result == SUCCESS) {
+			m_numWritten++;
+			m_bytesWritten += file->m_size;
+		}
+		else {
+			// Write it again on the next save, even if nothing changed
+			m_numFailed++;
+			RemoveSnapshot(file->m_path.GetData());
+		}
+
+		m_lock.Leave();
+
+		delete[] file->m_data;
+		delete file;
+
+		m_doneSemaphore.Release(1);
+	}
+}
+
+MxResult LegoSaveWriter::WriteFile(File* p_file)
+{
+	MxString tempPath = p_file->m_path;
+	tempPath += ".tmp";
+
+	{
+		LegoFile storage;
+
+		if (storage.Open(tempPath.GetData(), LegoFile::c_write) != SUCCESS ||
+			storage.Write(p_file->m_data, p_file->m_size) != SUCCESS) {
+			return FAILURE;
+		}
+	}
+
+	if (!MoveFileEx(tempPath.GetData(), p_file->m_path.GetData(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+		// The old file is still intact, unless MoveFileEx is missing as on Windows 95
+		if (GetLastError() != ERROR_CALL_NOT_IMPLEMENTED) {
+			DeleteFile(tempPath.GetData());
+			return FAILURE;
+		}
+
+		DeleteFile(p_file->m_path.GetData());
+
+		// Once the old file is gone, the temporary file is the only copy left
+		if (!MoveFile(tempPath.GetData(), p_file->m_path.GetData())) {
+			return FAILURE;
+		}
+	}
+
+	return SUCCESS;
+}
+
+void LegoSaveWriter::DeleteFiles(FileVector& p_files)
+{
+	for (FileVector::iterator it = p_files.begin(); it != p_files.end(); it++) {
+		delete[] (*it)->m_data;
+		delete *it;
+	}
+
+	p_files.erase(p_files.begin(), p_files.end());
+}
+
+LegoSaveWriter::File* LegoSaveWriter::FindSnapshot(const char* p_path)
+{
+	for (FileVector::iterator it = m_snapshots.begin(); it != m_snapshots.end(); it++) {
+		if (!strcmpi((*it)->m_path.GetData(), p_path)) {
+			return *it;
+		}
+	}
+
+	return NULL;
+}
+
+void LegoSaveWriter::RemoveSnapshot(const char* p_path)
+{
+	for (FileVector::iterator it = m_snapshots.begin(); it != m_snapshots.end(); it++) {
+		if (!strcmpi((*it)->m_path.GetData(), p_path)) {
+			delete[] (*it)->m_data;
+			delete *it;
+			m_snapshots.erase(it);
+			return;
+		}
+	}
+}
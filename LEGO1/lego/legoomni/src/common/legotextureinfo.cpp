@@ -5,10 +5,29 @@
 #include "misc/legoimage.h"
 #include "misc/legotexture.h"
 #include "mxdirectx/mxdirect3d.h"
+#include "mxrect32.h"
+#include "mxstl/stlcompat.h"
 #include "tgl/d3drm/impl.h"
 
 DECOMP_SIZE_ASSERT(LegoTextureInfo, 0x10)
 
+struct LegoTextureInfoCompare {
+	MxBool operator()(LegoTextureInfo* const& p_a, LegoTextureInfo* const& p_b) const { return p_a < p_b; }
+};
+
+typedef vector<MxRect32> LegoDirtyRectVector;
+typedef map<LegoTextureInfo*, LegoDirtyRectVector, LegoTextureInfoCompare> LegoDirtyRectMap;
+
+// Not part of the original game.
+// The rects changed since the last upload, per texture
+LegoDirtyRectMap g_dirtyRects;
+
+// Past this many pending rects, they are merged into their bounds
+const LegoU32 g_maxDirtyRects = 32;
+
+LegoU32 LegoTextureInfo::g_bytesCopied = 0;
+LegoU32 LegoTextureInfo::g_bytesSkipped = 0;
+
 // FUNCTION: LEGO1 0x10065bf0
 LegoTextureInfo::LegoTextureInfo()
 {
@@ -40,6 +59,12 @@ LegoTextureInfo::~LegoTextureInfo()
 		m_texture->Release();
 		m_texture = NULL;
 	}
+
+	LegoDirtyRectMap::iterator it = g_dirtyRects.find(this);
+
+	if (it != g_dirtyRects.end()) {
+		g_dirtyRects.erase(it);
+	}
 }
 
 // FUNCTION: LEGO1 0x10065c60
@@ -216,3 +241,119 @@ LegoResult LegoTextureInfo::FUN_10066010(const LegoU8* p_bits)
 
 	return FAILURE;
 }
+
+// Not part of the original game.
+void LegoTextureInfo::AddDirtyRect(const MxRect32& p_rect)
+{
+	LegoDirtyRectVector& rects = g_dirtyRects[this];
+
+	if (rects.size() < g_maxDirtyRects) {
+		rects.push_back(p_rect);
+		return;
+	}
+
+	MxRect32 bounds(p_rect);
+
+	for (LegoDirtyRectVector::iterator it = rects.begin(); it != rects.end(); it++) {
+		bounds.UpdateBounds(*it);
+	}
+
+	rects.erase(rects.begin(), rects.end());
+	rects.push_back(bounds);
+}
+
+// Not part of the original game.
+// Uploads the rects added since the last call
+LegoResult LegoTextureInfo::LoadDirtyBits(const LegoU8* p_bits, LegoBool p_bottomUp)
+{
+	LegoDirtyRectMap::iterator it = g_dirtyRects.find(this);
+
+	if (it == g_dirtyRects.end() || (*it).second.empty()) {
+		return SUCCESS;
+	}
+
+	LegoDirtyRectVector& rects = (*it).second;
+	LegoResult result = LoadBits(p_bits, &rects[0], rects.size(), p_bottomUp);
+	rects.erase(rects.begin(), rects.end());
+	return result;
+}
+
+// Not part of the original game.
+// Like FUN_10066010, but copies only the given rects of the image. If they
+// cover most of it anyway, the whole image is copied in one go instead.
+LegoResult LegoTextureInfo::LoadBits(
+	const LegoU8* p_bits,
+	const MxRect32* p_rects,
+	LegoS32 p_rectCount,
+	LegoBool p_bottomUp
+)
+{
+	if (m_surface == NULL || m_texture == NULL) {
+		return FAILURE;
+	}
+
+	DDSURFACEDESC desc;
+	memset(&desc, 0, sizeof(desc));
+	desc.dwSize = sizeof(desc);
+
+	if (m_surface->GetSurfaceDesc(&desc) != DD_OK) {
+		return FAILURE;
+	}
+
+	MxS32 width = desc.dwWidth;
+	MxS32 height = desc.dwHeight;
+	MxRect32 bounds(0, 0, width - 1, height - 1);
+	LegoU32 imageSize = width * height;
+	LegoU32 dirtySize = 0;
+	LegoS32 i;
+
+	for (i = 0; i < p_rectCount; i++) {
+		MxRect32 rect(p_rects[i], bounds);
+
+		if (rect.GetLeft() <= rect.GetRight() && rect.GetTop() <= rect.GetBottom()) {
+			dirtySize += rect.GetWidth() * rect.GetHeight();
+		}
+	}
+
+	if (dirtySize == 0) {
+		g_bytesSkipped += imageSize;
+		return SUCCESS;
+	}
+
+	if (dirtySize >= imageSize * 3 / 4) {
+		if (FUN_10066010(p_bits) != SUCCESS) {
+			return FAILURE;
+		}
+
+		g_bytesCopied += imageSize;
+		return SUCCESS;
+	}
+
+	if (m_surface->Lock(NULL, &desc, 0, NULL) != DD_OK) {
+		return FAILURE;
+	}
+
+	MxU8* surface = (MxU8*) desc.lpSurface;
+
+	for (i = 0; i < p_rectCount; i++) {
+		MxRect32 rect(p_rects[i], bounds);
+
+		if (rect.GetLeft() > rect.GetRight() || rect.GetTop() > rect.GetBottom()) {
+			continue;
+		}
+
+		for (MxS32 y = rect.GetTop(); y <= rect.GetBottom(); y++) {
+			MxS32 row = p_bottomUp ? (height - 1) - y : y;
+			memcpy(surface + row * desc.lPitch + rect.GetLeft(), p_bits + row * width + rect.GetLeft(), rect.GetWidth());
+		}
+	}
+
+	m_surface->Unlock(desc.lpSurface);
+
+	// IDirect3DRMTexture2 can only be invalidated as a whole
+	m_texture->Changed(TRUE, FALSE);
+
+	g_bytesCopied += dirtySize;
+	g_bytesSkipped += imageSize - dirtySize;
+	return SUCCESS;
+}
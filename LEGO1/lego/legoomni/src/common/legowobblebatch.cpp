@@ -0,0 +1,52 @@
+#include "legowobblebatch.h"
+
+#include "legoentity.h"
+
+#include <math.h>
+
+DECOMP_SIZE_ASSERT(LegoWobbleBatch, 0x2a4)
+
+MxResult LegoWobbleBatch::Add(LegoEntity* p_entity, MxLong p_endTime, float p_height, MxBool p_muted)
+{
+	if (p_entity == NULL || m_count == c_maxEntries) {
+		return FAILURE;
+	}
+
+	m_entities[m_count] = p_entity;
+	m_rois[m_count] = p_entity->GetROI();
+	m_endTimes[m_count] = p_endTime;
+	m_timeLeft[m_count] = p_endTime;
+	m_heights[m_count] = p_height;
+	m_muted[m_count] = p_muted;
+	m_count++;
+	return SUCCESS;
+}
+
+void LegoWobbleBatch::Remove(MxS32 p_index)
+{
+	m_count--;
+
+	if (p_index != m_count) {
+		m_entities[p_index] = m_entities[m_count];
+		m_rois[p_index] = m_rois[m_count];
+		m_endTimes[p_index] = m_endTimes[m_count];
+		m_timeLeft[p_index] = m_timeLeft[m_count];
+		m_heights[p_index] = m_heights[m_count];
+		m_muted[p_index] = m_muted[m_count];
+	}
+}
+
+void LegoWobbleBatch::Advance(MxLong p_time)
+{
+	for (MxS32 i = 0; i < m_count; i++) {
+		m_timeLeft[i] = m_endTimes[i] - p_time;
+	}
+}
+
+// Stores sin(time left * p_speed * 2pi / 1000) * p_amplitude for every entry
+void LegoWobbleBatch::ComputeWave(MxS32 p_speed, float p_amplitude, float* p_wave)
+{
+	for (MxS32 i = 0; i < m_count; i++) {
+		p_wave[i] = sin((m_timeLeft[i] * p_speed) * 0.0062832f) * p_amplitude;
+	}
+}
@@ -17,6 +17,8 @@ DECOMP_SIZE_ASSERT(MxTransitionManager, 0x900)
 // GLOBAL: LEGO1 0x100f4378
 RECT g_fullScreenRect = {0, 0, 640, 480};
 
+MxU32 MxTransitionManager::g_randomState = 0;
+
 // FUNCTION: LEGO1 0x1004b8d0
 MxTransitionManager::MxTransitionManager()
 {
@@ -116,6 +118,10 @@ MxResult MxTransitionManager::StartTransition(
 		MxU32 time = timeGetTime();
 		m_systemTime = time;
 
+		if (g_randomState == 0) {
+			SetRandomSeed(time);
+		}
+
 		m_animationSpeed = p_speed;
 
 		MxTickleManager* tickleManager = TickleManager();
@@ -189,7 +195,7 @@ void MxTransitionManager::DissolveTransition()
 
 		// ...then shuffle the list (to ensure that we hit each column once)
 		for (i = 0; i < 640; i++) {
-			MxS32 swap = rand() % 640;
+			MxS32 swap = Random() % 640;
 			MxU16 t = m_columnOrder[i];
 			m_columnOrder[i] = m_columnOrder[swap];
 			m_columnOrder[swap] = t;
@@ -197,7 +203,17 @@ void MxTransitionManager::DissolveTransition()
 
 		// For each scanline, pick a random X offset
 		for (i = 0; i < 480; i++) {
-			m_randomShift[i] = rand() % 640;
+			m_randomShift[i] = Random() % 640;
+		}
+	}
+
+	// Select 16 columns on each tick. This is done before locking the surface.
+	MxU16 columns[16];
+	MxS32 numColumns = 0;
+
+	for (MxS32 col = 0; col < 640 && numColumns < 16; col++) {
+		if (m_columnOrder[col] >= m_animationTimer * 16 && m_columnOrder[col] <= m_animationTimer * 16 + 15) {
+			columns[numColumns++] = col;
 		}
 	}
 
@@ -215,33 +231,14 @@ void MxTransitionManager::DissolveTransition()
 	if (res == DD_OK) {
 		SubmitCopyRect(&ddsd);
 
-		for (MxS32 col = 0; col < 640; col++) {
-			// Select 16 columns on each tick
-			if (m_animationTimer * 16 > m_columnOrder[col]) {
-				continue;
-			}
-
-			if (m_animationTimer * 16 + 15 < m_columnOrder[col]) {
-				continue;
-			}
-
-			for (MxS32 row = 0; row < 480; row++) {
-				// Shift the chosen column a different amount at each scanline.
-				// We use the same shift for that scanline each time.
-				// By the end, every pixel gets hit.
-				MxS32 xShift = (m_randomShift[row] + col) % 640;
-
-				// Set the chosen pixel to black
-				if (ddsd.ddpfPixelFormat.dwRGBBitCount == 8) {
-					MxU8* surf = (MxU8*) ddsd.lpSurface + ddsd.lPitch * row + xShift;
-					*surf = 0;
-				}
-				else {
-					MxU8* surf = (MxU8*) ddsd.lpSurface + ddsd.lPitch * row + xShift * 2;
-					*(MxU16*) surf = 0;
-				}
-			}
-		}
+		DissolveKernel(
+			(MxU8*) ddsd.lpSurface,
+			ddsd.lPitch,
+			ddsd.ddpfPixelFormat.dwRGBBitCount / 8,
+			columns,
+			numColumns,
+			m_randomShift
+		);
 
 		SetupCopyRect(&ddsd);
 		m_ddSurface->Unlock(ddsd.lpSurface);
@@ -274,7 +271,7 @@ void MxTransitionManager::MosaicTransition()
 			}
 
 			for (i = 0; i < 64; i++) {
-				MxS32 swap = rand() % 64;
+				MxS32 swap = Random() % 64;
 				MxU16 t = m_columnOrder[i];
 				m_columnOrder[i] = m_columnOrder[swap];
 				m_columnOrder[swap] = t;
@@ -282,7 +279,17 @@ void MxTransitionManager::MosaicTransition()
 
 			// The same is true here. We only need 48 rows.
 			for (i = 0; i < 48; i++) {
-				m_randomShift[i] = rand() % 64;
+				m_randomShift[i] = Random() % 64;
+			}
+		}
+
+		// Select 4 columns on each tick
+		MxU16 blocks[4];
+		MxS32 numBlocks = 0;
+
+		for (MxS32 col = 0; col < 64 && numBlocks < 4; col++) {
+			if (m_columnOrder[col] >= m_animationTimer * 4 && m_columnOrder[col] <= m_animationTimer * 4 + 3) {
+				blocks[numBlocks++] = col;
 			}
 		}
 
@@ -300,51 +307,14 @@ void MxTransitionManager::MosaicTransition()
 		if (res == DD_OK) {
 			SubmitCopyRect(&ddsd);
 
-			for (MxS32 col = 0; col < 64; col++) {
-				// Select 4 columns on each tick
-				if (m_animationTimer * 4 > m_columnOrder[col]) {
-					continue;
-				}
-
-				if (m_animationTimer * 4 + 3 < m_columnOrder[col]) {
-					continue;
-				}
-
-				for (MxS32 row = 0; row < 48; row++) {
-					// To do the mosaic effect, we subdivide the 640x480 surface into
-					// 10x10 pixel blocks. At the chosen block, we sample the top-leftmost
-					// color and set the other 99 pixels to that value.
-
-					// First, get the offset of the 10x10 block that we will sample for this row.
-					MxS32 xShift = 10 * ((m_randomShift[row] + col) % 64);
-
-					// Combine xShift with this value to target the correct location in the buffer.
-					MxS32 bytesPerPixel = ddsd.ddpfPixelFormat.dwRGBBitCount / 8;
-
-					// Seek to the sample position.
-					MxU8* source = (MxU8*) ddsd.lpSurface + 10 * row * ddsd.lPitch + bytesPerPixel * xShift;
-
-					// Sample byte or word depending on display mode.
-					MxU32 sample = bytesPerPixel == 1 ? *source : *(MxU16*) source;
-
-					// For each of the 10 rows in the 10x10 square:
-					for (MxS32 k = 10 * row; k < 10 * row + 10; k++) {
-						if (ddsd.ddpfPixelFormat.dwRGBBitCount == 8) {
-							// Optimization: If the pixel is only one byte, we can use memset
-							MxU8* pos = ((MxU8*) ddsd.lpSurface + k * ddsd.lPitch + xShift);
-							memset(pos, sample, 10);
-						}
-						else {
-							// Need to double xShift because it measures pixels not bytes
-							MxU16* pos = (MxU16*) ((MxU8*) ddsd.lpSurface + k * ddsd.lPitch + 2 * xShift);
-
-							for (MxS32 tt = 0; tt < 10; tt++) {
-								pos[tt] = sample;
-							}
-						}
-					}
-				}
-			}
+			MosaicKernel(
+				(MxU8*) ddsd.lpSurface,
+				ddsd.lPitch,
+				ddsd.ddpfPixelFormat.dwRGBBitCount / 8,
+				blocks,
+				numBlocks,
+				m_randomShift
+			);
 
 			SetupCopyRect(&ddsd);
 			m_ddSurface->Unlock(ddsd.lpSurface);
@@ -381,16 +351,7 @@ void MxTransitionManager::WipeDownTransition()
 
 	if (res == DD_OK) {
 		SubmitCopyRect(&ddsd);
-
-		// For each of the 240 animation ticks, blank out two scanlines
-		// starting at the top of the screen.
-		// (dwRGBBitCount / 8) will tell how many bytes are used per pixel.
-		MxU8* line = (MxU8*) ddsd.lpSurface + 2 * ddsd.lPitch * m_animationTimer;
-		memset(line, 0, 640 * ddsd.ddpfPixelFormat.dwRGBBitCount / 8);
-
-		line += ddsd.lPitch;
-		memset(line, 0, 640 * ddsd.ddpfPixelFormat.dwRGBBitCount / 8);
-
+		WipeDownKernel((MxU8*) ddsd.lpSurface, ddsd.lPitch, ddsd.ddpfPixelFormat.dwRGBBitCount / 8, m_animationTimer);
 		SetupCopyRect(&ddsd);
 		m_ddSurface->Unlock(ddsd.lpSurface);
 
@@ -419,24 +380,7 @@ void MxTransitionManager::WindowsTransition()
 
 	if (res == DD_OK) {
 		SubmitCopyRect(&ddsd);
-
-		MxU8* line = (MxU8*) ddsd.lpSurface + m_animationTimer * ddsd.lPitch;
-
-		MxS32 bytesPerPixel = ddsd.ddpfPixelFormat.dwRGBBitCount / 8;
-		MxS32 bytesPerLine = bytesPerPixel * 640;
-
-		memset(line, 0, bytesPerLine);
-
-		for (MxS32 i = m_animationTimer + 1; i < 480 - m_animationTimer; i++) {
-			line += ddsd.lPitch;
-
-			memset(line + m_animationTimer * bytesPerPixel, 0, bytesPerPixel);
-			memset(line + 640 + (-1 - m_animationTimer) * bytesPerPixel, 0, bytesPerPixel);
-		}
-
-		line += ddsd.lPitch;
-		memset(line, 0, bytesPerLine);
-
+		WindowsKernel((MxU8*) ddsd.lpSurface, ddsd.lPitch, ddsd.ddpfPixelFormat.dwRGBBitCount / 8, m_animationTimer);
 		SetupCopyRect(&ddsd);
 		m_ddSurface->Unlock(ddsd.lpSurface);
 
@@ -605,3 +549,159 @@ void MxTransitionManager::SetupCopyRect(LPDDSURFACEDESC p_ddsc)
 		);
 	}
 }
+
+// Fills p_count pixels with p_value. 16-bit pixels are written in pairs
+// once the destination is aligned to four bytes.
+inline void FillPixels(MxU8* p_dst, MxS32 p_bytesPerPixel, MxU32 p_value, MxS32 p_count)
+{
+	switch (p_bytesPerPixel) {
+	case 1:
+		memset(p_dst, p_value, p_count);
+		break;
+	case 2: {
+		MxU16* dst = (MxU16*) p_dst;
+
+		if (((size_t) dst & 2) && p_count > 0) {
+			*dst++ = (MxU16) p_value;
+			p_count--;
+		}
+
+		MxU32 pair = (p_value & 0xffff) | (p_value << 16);
+		MxU32* dst32 = (MxU32*) dst;
+
+		for (; p_count >= 2; p_count -= 2) {
+			*dst32++ = pair;
+		}
+
+		if (p_count > 0) {
+			*(MxU16*) dst32 = (MxU16) p_value;
+		}
+		break;
+	}
+	case 4: {
+		MxU32* dst = (MxU32*) p_dst;
+
+		while (p_count-- > 0) {
+			*dst++ = p_value;
+		}
+		break;
+	}
+	}
+}
+
+// Sets the given columns to black, shifted by a different amount on each scanline.
+// The buffer is traversed row by row so that each scanline is touched once.
+void MxTransitionManager::DissolveKernel(
+	MxU8* p_pixels,
+	MxS32 p_pitch,
+	MxS32 p_bytesPerPixel,
+	const MxU16* p_columns,
+	MxS32 p_numColumns,
+	const MxU16* p_randomShift
+)
+{
+	for (MxS32 row = 0; row < 480; row++) {
+		MxU8* line = p_pixels + p_pitch * row;
+		MxS32 shift = p_randomShift[row];
+
+		for (MxS32 i = 0; i < p_numColumns; i++) {
+			MxS32 x = shift + p_columns[i];
+
+			if (x >= 640) {
+				x -= 640;
+			}
+
+			switch (p_bytesPerPixel) {
+			case 1:
+				line[x] = 0;
+				break;
+			case 2:
+				((MxU16*) line)[x] = 0;
+				break;
+			case 4:
+				((MxU32*) line)[x] = 0;
+				break;
+			}
+		}
+	}
+}
+
+// Subdivides the 640x480 buffer into 10x10 pixel blocks. For each of the given
+// block columns, the block at a random position in each block row is filled with
+// the color of its top-left pixel.
+void MxTransitionManager::MosaicKernel(
+	MxU8* p_pixels,
+	MxS32 p_pitch,
+	MxS32 p_bytesPerPixel,
+	const MxU16* p_blocks,
+	MxS32 p_numBlocks,
+	const MxU16* p_randomShift
+)
+{
+	for (MxS32 row = 0; row < 48; row++) {
+		MxU8* line = p_pixels + 10 * row * p_pitch;
+
+		for (MxS32 i = 0; i < p_numBlocks; i++) {
+			MxS32 block = p_randomShift[row] + p_blocks[i];
+
+			if (block >= 64) {
+				block -= 64;
+			}
+
+			MxU8* source = line + p_bytesPerPixel * 10 * block;
+			MxU32 sample;
+
+			switch (p_bytesPerPixel) {
+			case 1:
+				sample = *source;
+				break;
+			case 2:
+				sample = *(MxU16*) source;
+				break;
+			default:
+				sample = *(MxU32*) source;
+				break;
+			}
+
+			for (MxS32 k = 0; k < 10; k++) {
+				FillPixels(source + k * p_pitch, p_bytesPerPixel, sample, 10);
+			}
+		}
+	}
+}
+
+// Blanks out two scanlines per step, starting at the top of the buffer
+void MxTransitionManager::WipeDownKernel(MxU8* p_pixels, MxS32 p_pitch, MxS32 p_bytesPerPixel, MxS32 p_step)
+{
+	MxU8* line = p_pixels + 2 * p_pitch * p_step;
+	memset(line, 0, 640 * p_bytesPerPixel);
+	memset(line + p_pitch, 0, 640 * p_bytesPerPixel);
+}
+
+// Draws the outline of a rectangle that shrinks towards the center with each step
+void MxTransitionManager::WindowsKernel(MxU8* p_pixels, MxS32 p_pitch, MxS32 p_bytesPerPixel, MxS32 p_step)
+{
+	MxU8* line = p_pixels + p_step * p_pitch;
+	MxS32 bytesPerLine = p_bytesPerPixel * 640;
+
+	memset(line, 0, bytesPerLine);
+
+	for (MxS32 i = p_step + 1; i < 480 - p_step; i++) {
+		line += p_pitch;
+
+		memset(line + p_step * p_bytesPerPixel, 0, p_bytesPerPixel);
+		memset(line + bytesPerLine + (-1 - p_step) * p_bytesPerPixel, 0, p_bytesPerPixel);
+	}
+
+	line += p_pitch;
+	memset(line, 0, bytesPerLine);
+}
+
+// xorshift32, used in place of rand() to shuffle the dissolve and mosaic orders
+MxU32 MxTransitionManager::Random()
+{
+	g_randomState ^= g_randomState << 13;
+	g_randomState ^= g_randomState >> 17;
+	g_randomState ^= g_randomState << 5;
+	return g_randomState;
+}
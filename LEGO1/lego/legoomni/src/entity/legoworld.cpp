@@ -16,13 +16,17 @@
 #include "legoutils.h"
 #include "legovideomanager.h"
 #include "misc.h"
+#include "misc/legocontainer.h"
 #include "mxactionnotificationparam.h"
 #include "mxcontrolpresenter.h"
+#include "mxdebug.h"
 #include "mxmisc.h"
 #include "mxnotificationmanager.h"
 #include "mxnotificationparam.h"
 #include "mxticklemanager.h"
+#include "mxtypeidtable.h"
 #include "mxutilities.h"
+#include "viewmanager/viewlodlist.h"
 #include "viewmanager/viewmanager.h"
 
 DECOMP_SIZE_ASSERT(LegoWorld, 0xf8)
@@ -31,6 +35,26 @@ DECOMP_SIZE_ASSERT(LegoEntityListCursor, 0x10)
 DECOMP_SIZE_ASSERT(LegoCacheSoundList, 0x18)
 DECOMP_SIZE_ASSERT(LegoCacheSoundListCursor, 0x10)
 
+// Not part of the original game.
+static MxTypeId g_typeLegoLocomotionAnimPresenter("LegoLocomotionAnimPresenter");
+static MxTypeId g_typeMxPresenter("MxPresenter");
+static MxTypeId g_typeLegoWorld("LegoWorld");
+static MxTypeId g_typeLegoWorldPresenter("LegoWorldPresenter");
+static MxTypeId g_typeLegoAnimPresenter("LegoAnimPresenter");
+static MxTypeId g_typeMxControlPresenter("MxControlPresenter");
+static MxTypeId g_typeMxEntity("MxEntity");
+static MxTypeId g_typeLegoHideAnimPresenter("LegoHideAnimPresenter");
+static MxTypeId g_typeLegoLoopingAnimPresenter("LegoLoopingAnimPresenter");
+static MxTypeId g_typeLegoCacheSound("LegoCacheSound");
+static MxTypeId g_typeLegoPathActor("LegoPathActor");
+static MxTypeId g_typeLegoPathController("LegoPathController");
+static MxTypeId g_typeLegoActionControlPresenter("LegoActionControlPresenter");
+
+// Not part of the original game.
+// The string allocations when the last world was created, to trace what loading
+// and running each world costs
+static MxU32 g_lastStringAllocations = 0;
+
 // FUNCTION: LEGO1 0x1001ca40
 LegoWorld::LegoWorld() : m_list0x68(TRUE)
 {
@@ -71,6 +95,33 @@ MxResult LegoWorld::Create(MxDSAction& p_dsAction)
 		return FAILURE;
 	}
 
+	MxTrace(
+		"Creating world %s: %u string allocations since the last world\n",
+		GetAtomId().GetInternal(),
+		MxString::GetNumAllocations() - g_lastStringAllocations
+	);
+	g_lastStringAllocations = MxString::GetNumAllocations();
+
+#ifdef _DEBUG
+	size_t lodSize, unsharedLodSize;
+	GetViewLODListManager()->GetMemoryStatistics(lodSize, unsharedLodSize);
+	MxTrace(
+		"Creating world %s: %u bytes of LOD geometry, %u if unshared\n",
+		GetAtomId().GetInternal(),
+		lodSize,
+		unsharedLodSize
+	);
+#endif
+
+	MxTrace(
+		"Creating world %s: %u texture cache hits, %u misses, %u textures created since the last world\n",
+		GetAtomId().GetInternal(),
+		TextureContainer()->GetNumCacheHits(),
+		TextureContainer()->GetNumCacheMisses(),
+		TextureContainer()->GetNumCacheCreations()
+	);
+	TextureContainer()->ResetCacheStatistics();
+
 	if (!VTable0x54()) {
 		return FAILURE;
 	}
@@ -115,7 +166,7 @@ void LegoWorld::Destroy(MxBool p_fromDestructor)
 
 		MxDSAction* action = presenter->GetAction();
 		if (action) {
-			if (presenter->IsA("LegoLocomotionAnimPresenter")) {
+			if (MxIsA(presenter, g_typeLegoLocomotionAnimPresenter)) {
 				LegoLocomotionAnimPresenter* animPresenter = (LegoLocomotionAnimPresenter*) presenter;
 
 				animPresenter->DecrementUnknown0xd4();
@@ -136,7 +187,7 @@ void LegoWorld::Destroy(MxBool p_fromDestructor)
 		MxCore* object = *it;
 		m_set0xa8.erase(it);
 
-		if (object->IsA("MxPresenter")) {
+		if (MxIsA(object, g_typeMxPresenter)) {
 			MxPresenter* presenter = (MxPresenter*) object;
 			MxDSAction* action = presenter->GetAction();
 
@@ -417,12 +468,12 @@ MxResult LegoWorld::GetCurrPathInfo(LegoPathBoundary** p_boundaries, MxS32& p_nu
 // FUNCTION: BETA10 0x100da90b
 void LegoWorld::Add(MxCore* p_object)
 {
-	if (p_object == NULL || p_object->IsA("LegoWorld") || p_object->IsA("LegoWorldPresenter")) {
+	if (p_object == NULL || MxIsA(p_object, g_typeLegoWorld) || MxIsA(p_object, g_typeLegoWorldPresenter)) {
 		return;
 	}
 
 #ifndef BETA10
-	if (p_object->IsA("LegoAnimPresenter")) {
+	if (MxIsA(p_object, g_typeLegoAnimPresenter)) {
 		if (!strcmpi(((LegoAnimPresenter*) p_object)->GetAction()->GetObjectName(), "ConfigAnimation")) {
 			FUN_1003e050((LegoAnimPresenter*) p_object);
 			((LegoAnimPresenter*) p_object)
@@ -432,7 +483,7 @@ void LegoWorld::Add(MxCore* p_object)
 	}
 #endif
 
-	if (p_object->IsA("MxControlPresenter")) {
+	if (MxIsA(p_object, g_typeMxControlPresenter)) {
 		MxPresenterListCursor cursor(&m_controlPresenters);
 
 		if (cursor.Find((MxPresenter*) p_object)) {
@@ -442,7 +493,7 @@ void LegoWorld::Add(MxCore* p_object)
 
 		m_controlPresenters.Append((MxPresenter*) p_object);
 	}
-	else if (p_object->IsA("MxEntity")) {
+	else if (MxIsA(p_object, g_typeMxEntity)) {
 		LegoEntityListCursor cursor(m_entityList);
 
 		if (cursor.Find((LegoEntity*) p_object)) {
@@ -452,7 +503,8 @@ void LegoWorld::Add(MxCore* p_object)
 
 		m_entityList->Append((LegoEntity*) p_object);
 	}
-	else if (p_object->IsA("LegoLocomotionAnimPresenter") || p_object->IsA("LegoHideAnimPresenter") || p_object->IsA("LegoLoopingAnimPresenter")) {
+	else if (MxIsA(p_object, g_typeLegoLocomotionAnimPresenter) || MxIsA(p_object, g_typeLegoHideAnimPresenter) ||
+			 MxIsA(p_object, g_typeLegoLoopingAnimPresenter)) {
 		MxPresenterListCursor cursor(&m_animPresenters);
 
 		if (cursor.Find((MxPresenter*) p_object)) {
@@ -463,12 +515,12 @@ void LegoWorld::Add(MxCore* p_object)
 		((MxPresenter*) p_object)->SendToCompositePresenter(Lego());
 		m_animPresenters.Append(((MxPresenter*) p_object));
 
-		if (p_object->IsA("LegoHideAnimPresenter")) {
+		if (MxIsA(p_object, g_typeLegoHideAnimPresenter)) {
 			m_hideAnim = (LegoHideAnimPresenter*) p_object;
 		}
 	}
 #ifndef BETA10
-	else if (p_object->IsA("LegoCacheSound")) {
+	else if (MxIsA(p_object, g_typeLegoCacheSound)) {
 		LegoCacheSoundListCursor cursor(m_cacheSoundList);
 
 		if (cursor.Find((LegoCacheSound*) p_object)) {
@@ -483,7 +535,7 @@ void LegoWorld::Add(MxCore* p_object)
 		MxCoreSet::iterator it = m_set0xa8.find(p_object);
 		if (it == m_set0xa8.end()) {
 #ifdef BETA10
-			if (p_object->IsA("MxPresenter")) {
+			if (MxIsA(p_object, g_typeMxPresenter)) {
 				assert(static_cast<MxPresenter*>(p_object)->GetAction());
 			}
 #endif
@@ -495,7 +547,7 @@ void LegoWorld::Add(MxCore* p_object)
 		}
 	}
 
-	if (m_set0xd0.size() != 0 && p_object->IsA("MxPresenter")) {
+	if (m_set0xd0.size() != 0 && MxIsA(p_object, g_typeMxPresenter)) {
 		if (((MxPresenter*) p_object)->IsEnabled()) {
 			((MxPresenter*) p_object)->Enable(FALSE);
 			m_set0xd0.insert(p_object);
@@ -513,7 +565,7 @@ void LegoWorld::Remove(MxCore* p_object)
 		return;
 	}
 
-	if (p_object->IsA("MxControlPresenter")) {
+	if (MxIsA(p_object, g_typeMxControlPresenter)) {
 		MxPresenterListCursor cursor(&m_controlPresenters);
 
 		if (cursor.Find((MxControlPresenter*) p_object)) {
@@ -522,19 +574,20 @@ void LegoWorld::Remove(MxCore* p_object)
 			((MxControlPresenter*) p_object)->VTable0x68(TRUE);
 		}
 	}
-	else if (p_object->IsA("LegoLocomotionAnimPresenter") || p_object->IsA("LegoHideAnimPresenter") || p_object->IsA("LegoLoopingAnimPresenter")) {
+	else if (MxIsA(p_object, g_typeLegoLocomotionAnimPresenter) || MxIsA(p_object, g_typeLegoHideAnimPresenter) ||
+			 MxIsA(p_object, g_typeLegoLoopingAnimPresenter)) {
 		MxPresenterListCursor cursor(&m_animPresenters);
 
 		if (cursor.Find((MxPresenter*) p_object)) {
 			cursor.Detach();
 		}
 
-		if (p_object->IsA("LegoHideAnimPresenter")) {
+		if (MxIsA(p_object, g_typeLegoHideAnimPresenter)) {
 			m_hideAnim = NULL;
 		}
 	}
-	else if (p_object->IsA("MxEntity")) {
-		if (p_object->IsA("LegoPathActor")) {
+	else if (MxIsA(p_object, g_typeMxEntity)) {
+		if (MxIsA(p_object, g_typeLegoPathActor)) {
 			RemoveActor((LegoPathActor*) p_object);
 		}
 
@@ -547,7 +600,7 @@ void LegoWorld::Remove(MxCore* p_object)
 		}
 	}
 #ifndef BETA10
-	else if (p_object->IsA("LegoCacheSound")) {
+	else if (MxIsA(p_object, g_typeLegoCacheSound)) {
 		LegoCacheSoundListCursor cursor(m_cacheSoundList);
 
 		if (cursor.Find((LegoCacheSound*) p_object)) {
@@ -617,7 +670,7 @@ MxCore* LegoWorld::Find(const char* p_class, const char* p_name)
 	}
 
 	for (MxCoreSet::iterator i = m_set0xa8.begin(); i != m_set0xa8.end(); i++) {
-		if ((*i)->IsA(p_class) && (*i)->IsA("MxPresenter")) {
+		if ((*i)->IsA(p_class) && MxIsA(*i, g_typeMxPresenter)) {
 			assert(((MxPresenter*) (*i))->GetAction());
 
 			if (!strcmp(((MxPresenter*) (*i))->GetAction()->GetObjectName(), p_name)) {
@@ -665,7 +718,7 @@ MxCore* LegoWorld::Find(const MxAtomId& p_atom, MxS32 p_entityId)
 	for (MxCoreSet::iterator it = m_set0xa8.begin(); it != m_set0xa8.end(); it++) {
 		MxCore* core = *it;
 
-		if (core->IsA("MxPresenter")) {
+		if (MxIsA(core, g_typeMxPresenter)) {
 			MxPresenter* presenter = (MxPresenter*) *it;
 			MxDSAction* action = presenter->GetAction();
 
@@ -710,10 +763,10 @@ void LegoWorld::Enable(MxBool p_enable)
 		while (m_set0xd0.size() != 0) {
 			it = m_set0xd0.begin();
 
-			if ((*it)->IsA("MxPresenter")) {
+			if (MxIsA(*it, g_typeMxPresenter)) {
 				((MxPresenter*) *it)->Enable(TRUE);
 			}
-			else if ((*it)->IsA("LegoPathController")) {
+			else if (MxIsA(*it, g_typeLegoPathController)) {
 				((LegoPathController*) *it)->Enable(TRUE);
 			}
 
@@ -770,8 +823,8 @@ void LegoWorld::Enable(MxBool p_enable)
 		}
 
 		for (MxCoreSet::iterator it = m_set0xa8.begin(); it != m_set0xa8.end(); it++) {
-			if ((*it)->IsA("LegoActionControlPresenter") ||
-				((*it)->IsA("MxPresenter") && ((MxPresenter*) *it)->IsEnabled())) {
+			if (MxIsA(*it, g_typeLegoActionControlPresenter) ||
+				(MxIsA(*it, g_typeMxPresenter) && ((MxPresenter*) *it)->IsEnabled())) {
 				m_set0xd0.insert(*it);
 				((MxPresenter*) *it)->Enable(FALSE);
 			}
@@ -843,7 +896,7 @@ MxBool LegoWorld::PresentersPending()
 
 	while (animPresenterCursor.Next(presenter)) {
 		if (presenter->IsEnabled()) {
-			if (presenter->IsA("LegoLocomotionAnimPresenter")) {
+			if (MxIsA(presenter, g_typeLegoLocomotionAnimPresenter)) {
 				if (!presenter->HasTickleStatePassed(MxPresenter::e_ready)) {
 					return TRUE;
 				}
@@ -857,7 +910,7 @@ MxBool LegoWorld::PresentersPending()
 	}
 
 	for (MxCoreSet::iterator it = m_set0xa8.begin(); it != m_set0xa8.end(); it++) {
-		if ((*it)->IsA("MxPresenter")) {
+		if (MxIsA(*it, g_typeMxPresenter)) {
 			presenter = (MxPresenter*) *it;
 
 			if (presenter->IsEnabled() && !presenter->HasTickleStatePassed(MxPresenter::e_starting)) {
@@ -196,7 +196,10 @@ MxResult LegoWorldPresenter::LoadWorld(char* p_worldName, LegoWorld* p_world)
 		return FAILURE;
 	}
 
-	ReadModelDbWorlds(wdbFile, worlds, numWorlds);
+	if (ReadCachedModelDbWorlds(wdbFile, worlds, numWorlds) != SUCCESS) {
+		fclose(wdbFile);
+		return FAILURE;
+	}
 
 	for (i = 0; i < numWorlds; i++) {
 		if (!strcmpi(worlds[i].m_worldName, p_worldName)) {
@@ -308,7 +311,6 @@ MxResult LegoWorldPresenter::LoadWorld(char* p_worldName, LegoWorld* p_world)
 		}
 	}
 
-	FreeModelDbWorlds(worlds, numWorlds);
 	fclose(wdbFile);
 	return SUCCESS;
 }
@@ -2,6 +2,7 @@
 
 #include "legocameracontroller.h"
 #include "legocontrolmanager.h"
+#include "legoinputrecorder.h"
 #include "legomain.h"
 #include "legoutils.h"
 #include "legovideomanager.h"
@@ -9,6 +10,8 @@
 #include "misc.h"
 #include "mxautolock.h"
 #include "mxdebug.h"
+#include "mxmisc.h"
+#include "mxticklemanager.h"
 #include "roi/legoroi.h"
 
 DECOMP_SIZE_ASSERT(LegoInputManager, 0x338)
@@ -25,6 +28,12 @@ const char* g_unk0x100f31b4 = NULL;
 // GLOBAL: LEGO1 0x100f67b8
 MxBool g_unk0x100f67b8 = TRUE;
 
+LegoInputManager::EventMode LegoInputManager::g_eventMode = LegoInputManager::e_immediate;
+MxU32 LegoInputManager::g_eventBudget = 16;
+MxU32 LegoInputManager::g_numMergedEvents = 0;
+MxU32 LegoInputManager::g_numDeferredEvents = 0;
+MxU32 LegoInputManager::g_numCountedEvents = 0;
+
 // FUNCTION: LEGO1 0x1005b790
 LegoInputManager::LegoInputManager()
 {
@@ -80,6 +89,9 @@ MxResult LegoInputManager::Create(HWND p_hwnd)
 		Destroy();
 		result = FAILURE;
 	}
+	else {
+		LegoInputRecorder::Startup();
+	}
 
 	return result;
 }
@@ -87,6 +99,11 @@ MxResult LegoInputManager::Create(HWND p_hwnd)
 // FUNCTION: LEGO1 0x1005bfe0
 void LegoInputManager::Destroy()
 {
+	if (g_eventMode == e_coalesced) {
+		TickleManager()->UnregisterClient(this);
+	}
+
+	LegoInputRecorder::Shutdown();
 	ReleaseDX();
 
 	if (m_keyboardNotifyList) {
@@ -162,7 +179,15 @@ MxResult LegoInputManager::GetNavigationKeyStates(MxU32& p_keyFlags)
 {
 	GetKeyboardState();
 
+	LegoInputRecorder* recorder = LegoInputRecorder::GetActive();
+
 	if (!m_kbStateSuccess) {
+		// A log being played back does not need the keyboard
+		if (recorder != NULL && recorder->GetState() == LegoInputRecorder::e_playing) {
+			recorder->FilterKeyStates(p_keyFlags);
+			return SUCCESS;
+		}
+
 		return FAILURE;
 	}
 
@@ -198,6 +223,10 @@ MxResult LegoInputManager::GetNavigationKeyStates(MxU32& p_keyFlags)
 		keyFlags |= c_bit5;
 	}
 
+	if (recorder != NULL) {
+		recorder->FilterKeyStates(keyFlags);
+	}
+
 	p_keyFlags = keyFlags;
 
 	return SUCCESS;
@@ -341,11 +370,28 @@ void LegoInputManager::ClearWorld()
 // FUNCTION: LEGO1 0x1005c740
 void LegoInputManager::QueueEvent(NotificationId p_id, MxU8 p_modifier, MxLong p_x, MxLong p_y, MxU8 p_key)
 {
+	LegoInputRecorder* recorder = LegoInputRecorder::GetActive();
+	if (recorder != NULL && !recorder->FilterEvent(p_id, p_modifier, p_x, p_y, p_key)) {
+		return;
+	}
+
 	LegoEventNotificationParam param = LegoEventNotificationParam(p_id, NULL, p_modifier, p_x, p_y, p_key);
 
 	if (((!m_unk0x88) || ((m_unk0x335 && (param.GetNotification() == c_notificationButtonDown)))) ||
 		((m_unk0x336 && (p_key == VK_SPACE)))) {
-		ProcessOneEvent(param);
+		if (g_eventMode == e_coalesced) {
+			AUTOLOCK(m_criticalSection);
+
+			if (m_eventQueue->MergeMotion(param)) {
+				g_numMergedEvents++;
+			}
+			else {
+				m_eventQueue->Enqueue(param);
+			}
+		}
+		else {
+			ProcessOneEvent(param);
+		}
 	}
 }
 
@@ -355,11 +401,46 @@ void LegoInputManager::ProcessEvents()
 	AUTOLOCK(m_criticalSection);
 
 	LegoEventNotificationParam event;
-	while (m_eventQueue->Dequeue(event)) {
+	MxU32 numEvents = 0;
+
+	while (numEvents < g_eventBudget && m_eventQueue->Dequeue(event)) {
+		numEvents++;
+
 		if (ProcessOneEvent(event)) {
 			break;
 		}
 	}
+
+	// Events left over are counted as deferred once, on the first tickle
+	// that leaves them waiting. Those at the front were counted before.
+	MxU32 numCounted = g_numCountedEvents > numEvents ? g_numCountedEvents - numEvents : 0;
+	g_numDeferredEvents += m_eventQueue->GetCount() - numCounted;
+	g_numCountedEvents = m_eventQueue->GetCount();
+}
+
+void LegoInputManager::SetEventMode(EventMode p_mode)
+{
+	if (p_mode == g_eventMode) {
+		return;
+	}
+
+	if (p_mode == e_coalesced) {
+		TickleManager()->RegisterClient(this, 10);
+	}
+	else {
+		// Flush all events that are still waiting
+		MxU32 eventBudget = g_eventBudget;
+		g_eventBudget = UINT_MAX;
+
+		while (m_eventQueue->GetCount() != 0) {
+			ProcessEvents();
+		}
+
+		g_eventBudget = eventBudget;
+		TickleManager()->UnregisterClient(this);
+	}
+
+	g_eventMode = p_mode;
 }
 
 // FUNCTION: LEGO1 0x1005c9c0
@@ -0,0 +1,299 @@
+#include "legoinputrecorder.h"
+
+#include "legoinputmanager.h"
+#include "misc.h"
+#include "misc/legostorage.h"
+#include "mxmisc.h"
+#include "mxticklemanager.h"
+#include "mxtimer.h"
+
+#include <string.h>
+
+DECOMP_SIZE_ASSERT(LegoInputRecorder, 0x34)
+
+LegoInputRecorder* LegoInputRecorder::g_activeRecorder = NULL;
+LegoInputRecorder* LegoInputRecorder::g_logRecorder = NULL;
+char* LegoInputRecorder::g_logFilename = NULL;
+MxBool LegoInputRecorder::g_logPlayback = FALSE;
+
+LegoInputRecorder::LegoInputRecorder()
+{
+	m_state = e_idle;
+	m_file = NULL;
+	m_startTime = 0;
+	m_hasNext = FALSE;
+	m_dispatching = FALSE;
+	m_numEvents = 0;
+	m_keyFlags = 0;
+}
+
+LegoInputRecorder::~LegoInputRecorder()
+{
+	Stop();
+}
+
+MxResult LegoInputRecorder::Open(const char* p_filename, MxU32 p_mode)
+{
+	if (g_activeRecorder != NULL) {
+		return FAILURE;
+	}
+
+	m_file = new LegoFile();
+
+	if (m_file->Open(p_filename, p_mode) != SUCCESS) {
+		delete m_file;
+		m_file = NULL;
+		return FAILURE;
+	}
+
+	g_activeRecorder = this;
+	m_startTime = Timer()->GetTime();
+	m_numEvents = 0;
+	m_keyFlags = 0;
+	return SUCCESS;
+}
+
+MxResult LegoInputRecorder::StartRecording(const char* p_filename)
+{
+	if (Open(p_filename, LegoFile::c_write) != SUCCESS) {
+		return FAILURE;
+	}
+
+	MxU32 magic = c_magic;
+	MxU32 version = c_version;
+
+	if (m_file->Write(&magic, sizeof(magic)) != SUCCESS || m_file->Write(&version, sizeof(version)) != SUCCESS) {
+		Stop();
+		return FAILURE;
+	}
+
+	m_state = e_recording;
+	return SUCCESS;
+}
+
+MxResult LegoInputRecorder::StartPlayback(const char* p_filename)
+{
+	if (Open(p_filename, LegoFile::c_read) != SUCCESS) {
+		return FAILURE;
+	}
+
+	MxU32 magic;
+	MxU32 version;
+
+	if (m_file->Read(&magic, sizeof(magic)) != SUCCESS || m_file->Read(&version, sizeof(version)) != SUCCESS ||
+		magic != c_magic || version != c_version) {
+		Stop();
+		return FAILURE;
+	}
+
+	m_state = e_playing;
+	m_hasNext = ReadEvent(m_nextEvent) == SUCCESS;
+	TickleManager()->RegisterClient(this, 10);
+	return SUCCESS;
+}
+
+void LegoInputRecorder::Stop()
+{
+	if (m_state == e_playing) {
+		TickleManager()->UnregisterClient(this);
+	}
+
+	if (m_file != NULL) {
+		delete m_file;
+		m_file = NULL;
+	}
+
+	if (g_activeRecorder == this) {
+		g_activeRecorder = NULL;
+	}
+
+	m_state = e_idle;
+	m_hasNext = FALSE;
+	m_keyFlags = 0;
+}
+
+// Sets the log to record to, or to play back if p_playback is set.
+// Takes effect when the input manager is created. NULL records nothing.
+void LegoInputRecorder::SetLog(const char* p_filename, MxBool p_playback)
+{
+	delete[] g_logFilename;
+	g_logFilename = NULL;
+
+	if (p_filename != NULL && *p_filename != '\0') {
+		g_logFilename = new char[strlen(p_filename) + 1];
+		strcpy(g_logFilename, p_filename);
+	}
+
+	g_logPlayback = p_playback;
+}
+
+// Called by LegoInputManager::Create
+void LegoInputRecorder::Startup()
+{
+	if (g_logFilename == NULL || g_logRecorder != NULL) {
+		return;
+	}
+
+	g_logRecorder = new LegoInputRecorder;
+
+	MxResult result =
+		g_logPlayback ? g_logRecorder->StartPlayback(g_logFilename) : g_logRecorder->StartRecording(g_logFilename);
+
+	if (result != SUCCESS) {
+		delete g_logRecorder;
+		g_logRecorder = NULL;
+	}
+}
+
+// Called by LegoInputManager::Destroy
+void LegoInputRecorder::Shutdown()
+{
+	delete g_logRecorder;
+	g_logRecorder = NULL;
+}
+
+MxResult LegoInputRecorder::Tickle()
+{
+	if (m_state != e_playing) {
+		return SUCCESS;
+	}
+
+	MxLong time = Timer()->GetTime() - m_startTime;
+
+	while (m_hasNext && m_nextEvent.m_time <= time) {
+		if (m_nextEvent.m_id == c_keyStates) {
+			m_keyFlags = m_nextEvent.m_x;
+		}
+		else {
+			m_dispatching = TRUE;
+			InputManager()->QueueEvent(
+				(NotificationId) m_nextEvent.m_id,
+				m_nextEvent.m_modifier,
+				m_nextEvent.m_x,
+				m_nextEvent.m_y,
+				m_nextEvent.m_key
+			);
+			m_dispatching = FALSE;
+		}
+
+		m_numEvents++;
+		m_hasNext = ReadEvent(m_nextEvent) == SUCCESS;
+	}
+
+	if (!m_hasNext) {
+		Stop();
+	}
+
+	return SUCCESS;
+}
+
+// Called by LegoInputManager::QueueEvent for every incoming event.
+// Returns FALSE if the event should be dropped, which is the case for
+// live input while a recording is being played back.
+MxBool LegoInputRecorder::FilterEvent(NotificationId p_id, MxU8 p_modifier, MxLong p_x, MxLong p_y, MxU8 p_key)
+{
+	switch (m_state) {
+	case e_recording: {
+		Event event;
+		event.m_time = Timer()->GetTime() - m_startTime;
+		event.m_id = p_id;
+		event.m_modifier = p_modifier;
+		event.m_x = p_x;
+		event.m_y = p_y;
+		event.m_key = p_key;
+
+		if (WriteEvent(event) == SUCCESS) {
+			m_numEvents++;
+		}
+		else {
+			Stop();
+		}
+
+		return TRUE;
+	}
+	case e_playing:
+		return m_dispatching;
+	default:
+		return TRUE;
+	}
+}
+
+// Called by LegoInputManager::GetNavigationKeyStates with the polled keys.
+// Records them if they changed, or replaces them with the recorded ones.
+void LegoInputRecorder::FilterKeyStates(MxU32& p_keyFlags)
+{
+	switch (m_state) {
+	case e_recording:
+		if (p_keyFlags != m_keyFlags) {
+			Event event;
+			event.m_time = Timer()->GetTime() - m_startTime;
+			event.m_id = c_keyStates;
+			event.m_modifier = 0;
+			event.m_x = p_keyFlags;
+			event.m_y = 0;
+			event.m_key = 0;
+
+			if (WriteEvent(event) == SUCCESS) {
+				m_keyFlags = p_keyFlags;
+				m_numEvents++;
+			}
+			else {
+				Stop();
+			}
+		}
+		break;
+	case e_playing:
+		p_keyFlags = m_keyFlags;
+		break;
+	default:
+		break;
+	}
+}
+
+MxResult LegoInputRecorder::WriteEvent(Event& p_event)
+{
+	if (m_file->Write(&p_event.m_time, sizeof(p_event.m_time)) != SUCCESS) {
+		return FAILURE;
+	}
+	if (m_file->Write(&p_event.m_id, sizeof(p_event.m_id)) != SUCCESS) {
+		return FAILURE;
+	}
+	if (m_file->Write(&p_event.m_modifier, sizeof(p_event.m_modifier)) != SUCCESS) {
+		return FAILURE;
+	}
+	if (m_file->Write(&p_event.m_x, sizeof(p_event.m_x)) != SUCCESS) {
+		return FAILURE;
+	}
+	if (m_file->Write(&p_event.m_y, sizeof(p_event.m_y)) != SUCCESS) {
+		return FAILURE;
+	}
+	if (m_file->Write(&p_event.m_key, sizeof(p_event.m_key)) != SUCCESS) {
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+MxResult LegoInputRecorder::ReadEvent(Event& p_event)
+{
+	if (m_file->Read(&p_event.m_time, sizeof(p_event.m_time)) != SUCCESS) {
+		return FAILURE;
+	}
+	if (m_file->Read(&p_event.m_id, sizeof(p_event.m_id)) != SUCCESS) {
+		return FAILURE;
+	}
+	if (m_file->Read(&p_event.m_modifier, sizeof(p_event.m_modifier)) != SUCCESS) {
+		return FAILURE;
+	}
+	if (m_file->Read(&p_event.m_x, sizeof(p_event.m_x)) != SUCCESS) {
+		return FAILURE;
+	}
+	if (m_file->Read(&p_event.m_y, sizeof(p_event.m_y)) != SUCCESS) {
+		return FAILURE;
+	}
+	if (m_file->Read(&p_event.m_key, sizeof(p_event.m_key)) != SUCCESS) {
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
@@ -17,6 +17,7 @@
 #include "legoworldlist.h"
 #include "misc.h"
 #include "misc/legocontainer.h"
+#include "modeldb/modeldb.h"
 #include "mxactionnotificationparam.h"
 #include "mxautolock.h"
 #include "mxbackgroundaudiomanager.h"
@@ -29,6 +30,7 @@
 #include "mxticklemanager.h"
 #include "mxtransitionmanager.h"
 #include "mxvariabletable.h"
+#include "roi/legolod.h"
 #include "scripts.h"
 #include "viewmanager/viewmanager.h"
 
@@ -129,6 +131,8 @@ void LegoOmni::Destroy()
 	}
 
 	LegoPathController::Reset();
+	FreeCachedModelDbWorlds();
+	LegoLOD::FreeScratch();
 
 	if (m_bkgAudioManager) {
 		m_bkgAudioManager->Stop();
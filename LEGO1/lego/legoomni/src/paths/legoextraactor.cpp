@@ -2,6 +2,7 @@
 
 #include "anim/legoanim.h"
 #include "legocachesoundmanager.h"
+#include "legoextraactorscheduler.h"
 #include "legolocomotionanimpresenter.h"
 #include "legosoundmanager.h"
 #include "legoworld.h"
@@ -439,6 +440,11 @@ inline MxU32 LegoExtraActor::VTable0x6c(
 		}
 	}
 
+	// Actors that are far away or off-screen leave collisions to the near ones
+	if (!LegoExtraActorScheduler::GetInstance()->HasFullCollision(this)) {
+		return 0;
+	}
+
 	LegoPathActorSet& plpas = p_boundary->GetActors();
 	LegoPathActorSet lpas(plpas);
 
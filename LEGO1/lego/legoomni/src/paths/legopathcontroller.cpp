@@ -1,5 +1,6 @@
 #include "legopathcontroller.h"
 
+#include "legoextraactorscheduler.h"
 #include "legopathedgecontainer.h"
 #include "misc/legostorage.h"
 #include "mxmisc.h"
@@ -375,7 +376,7 @@ void LegoPathController::FUN_10046970()
 
 		if (m_actors.find(actor) != m_actors.end()) {
 			if (!((MxU8) actor->GetActorState() & LegoPathActor::c_disabled)) {
-				actor->Animate(time);
+				LegoExtraActorScheduler::GetInstance()->Animate(actor, time);
 			}
 		}
 	}
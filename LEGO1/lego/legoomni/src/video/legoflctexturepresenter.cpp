@@ -57,6 +57,12 @@ void LegoFlcTexturePresenter::LoadFrame(MxStreamChunk* p_chunk)
 		(FLIC_FRAME*) data,
 		&decodedColorMap
 	);
+
+	if (m_texture != NULL) {
+		for (MxS32 i = 0; i < m_rectCount; i++) {
+			m_texture->AddDirtyRect(rects[i]);
+		}
+	}
 }
 
 // FUNCTION: LEGO1 0x1005e100
@@ -64,7 +70,7 @@ void LegoFlcTexturePresenter::LoadFrame(MxStreamChunk* p_chunk)
 void LegoFlcTexturePresenter::PutFrame()
 {
 	if (m_texture != NULL && m_rectCount != 0) {
-		m_texture->FUN_10066010(m_frameBitmap->GetImage());
+		m_texture->LoadDirtyBits(m_frameBitmap->GetImage(), !m_frameBitmap->IsTopDown());
 		m_rectCount = 0;
 	}
 }
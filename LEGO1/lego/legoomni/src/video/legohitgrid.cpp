@@ -0,0 +1,91 @@
+#include "legohitgrid.h"
+
+#include "mxutilities.h"
+#include "mxvideopresenter.h"
+
+LegoHitGrid::LegoHitGrid()
+{
+	m_presenters = NULL;
+	m_version = 0;
+}
+
+void LegoHitGrid::Clear()
+{
+	for (MxS32 i = 0; i < c_numTiles; i++) {
+		m_tiles[i].clear();
+	}
+
+	m_presenters = NULL;
+	m_version = 0;
+}
+
+void LegoHitGrid::Build(MxPresenterList* p_presenters, MxU32 p_version)
+{
+	Clear();
+
+	MxPresenterListCursor cursor(p_presenters);
+	MxPresenter* presenter;
+
+	// Same back to front order as LegoVideoManager::GetPresenterAt
+	while (cursor.Prev(presenter)) {
+		// Only video presenters implement IsHit, the others can never be hit
+		if (!presenter->IsA("MxVideoPresenter")) {
+			continue;
+		}
+
+		MxVideoPresenter* videoPresenter = (MxVideoPresenter*) presenter;
+		MxS32 width, height;
+
+		// Prefer the bitmap over the alpha mask, as MxVideoPresenter::IsHit does
+		if (videoPresenter->GetBitmap() != NULL) {
+			width = videoPresenter->GetBitmap()->GetBmiWidth();
+			height = videoPresenter->GetBitmap()->GetBmiHeightAbs();
+		}
+		else if (videoPresenter->GetAlphaMask() != NULL) {
+			width = videoPresenter->GetAlphaMask()->m_width;
+			height = videoPresenter->GetAlphaMask()->m_height;
+		}
+		else {
+			continue;
+		}
+
+		MxS32 left = Max(videoPresenter->GetX(), 0);
+		MxS32 top = Max(videoPresenter->GetY(), 0);
+		MxS32 right = Min(videoPresenter->GetX() + width, c_columns * c_tileSize) - 1;
+		MxS32 bottom = Min(videoPresenter->GetY() + height, c_rows * c_tileSize) - 1;
+
+		if (left > right || top > bottom) {
+			continue;
+		}
+
+		for (MxS32 row = top >> c_tileShift; row <= bottom >> c_tileShift; row++) {
+			for (MxS32 column = left >> c_tileShift; column <= right >> c_tileShift; column++) {
+				m_tiles[row * c_columns + column].push_back(presenter);
+			}
+		}
+	}
+
+	m_presenters = p_presenters;
+	m_version = p_version;
+}
+
+// Returns FALSE if the point lies outside of the grid, in which case the
+// caller has to fall back to walking the whole presenter list.
+MxBool LegoHitGrid::Find(MxS32 p_x, MxS32 p_y, MxPresenter*& p_presenter)
+{
+	if (p_x < 0 || p_y < 0 || p_x >= c_columns * c_tileSize || p_y >= c_rows * c_tileSize) {
+		return FALSE;
+	}
+
+	LegoHitGridTile& tile = m_tiles[(p_y >> c_tileShift) * c_columns + (p_x >> c_tileShift)];
+	p_presenter = NULL;
+
+	for (MxU32 i = 0; i < tile.size(); i++) {
+		if (tile[i]->IsHit(p_x, p_y)) {
+			p_presenter = tile[i];
+			break;
+		}
+	}
+
+	return TRUE;
+}
@@ -107,6 +107,12 @@ void LegoPhonemePresenter::LoadFrame(MxStreamChunk* p_chunk)
 		(FLIC_FRAME*) data,
 		&decodedColorMap
 	);
+
+	if (m_textureInfo != NULL) {
+		for (MxS32 i = 0; i < m_rectCount; i++) {
+			m_textureInfo->AddDirtyRect(rects[i]);
+		}
+	}
 }
 
 // FUNCTION: LEGO1 0x1004e840
@@ -114,7 +120,7 @@ void LegoPhonemePresenter::LoadFrame(MxStreamChunk* p_chunk)
 void LegoPhonemePresenter::PutFrame()
 {
 	if (m_textureInfo != NULL && m_rectCount != 0) {
-		m_textureInfo->FUN_10066010(m_frameBitmap->GetImage());
+		m_textureInfo->LoadDirtyBits(m_frameBitmap->GetImage(), !m_frameBitmap->IsTopDown());
 		m_rectCount = 0;
 	}
 }
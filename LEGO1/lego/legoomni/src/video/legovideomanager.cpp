@@ -1,6 +1,7 @@
 #include "legovideomanager.h"
 
 #include "3dmanager/lego3dmanager.h"
+#include "legohitgrid.h"
 #include "legoinputmanager.h"
 #include "legomain.h"
 #include "misc.h"
@@ -25,6 +26,9 @@ DECOMP_SIZE_ASSERT(LegoVideoManager, 0x590)
 DECOMP_SIZE_ASSERT(MxStopWatch, 0x18)
 DECOMP_SIZE_ASSERT(MxFrequencyMeter, 0x20)
 
+// Not part of the original game.
+LegoHitGrid g_presenterHitGrid;
+
 // FUNCTION: LEGO1 0x1007aa20
 LegoVideoManager::LegoVideoManager()
 {
@@ -252,6 +256,7 @@ void LegoVideoManager::Destroy()
 
 	delete m_3dManager;
 	MxVideoManager::Destroy();
+	g_presenterHitGrid.Clear();
 	delete m_phonemeRefList;
 	delete m_stopWatch;
 }
@@ -516,8 +521,17 @@ void LegoVideoManager::DrawFPS()
 // FUNCTION: LEGO1 0x1007c080
 MxPresenter* LegoVideoManager::GetPresenterAt(MxS32 p_x, MxS32 p_y)
 {
-	MxPresenterListCursor cursor(m_presenters);
+	MxU32 version = GetLayoutVersion();
+	if (!g_presenterHitGrid.IsBuilt(m_presenters, version)) {
+		g_presenterHitGrid.Build(m_presenters, version);
+	}
+
 	MxPresenter* presenter;
+	if (g_presenterHitGrid.Find(p_x, p_y, presenter)) {
+		return presenter;
+	}
+
+	MxPresenterListCursor cursor(m_presenters);
 
 	while (cursor.Prev(presenter)) {
 		if (presenter->IsHit(p_x, p_y)) {
@@ -9,62 +9,163 @@ DECOMP_SIZE_ASSERT(LegoContainerInfo<LegoTexture>, 0x10);
 // DECOMP_SIZE_ASSERT(LegoContainer<LegoTexture>, 0x18);
 DECOMP_SIZE_ASSERT(LegoTextureContainer, 0x24);
 
+// Not part of the original game.
+// The cached textures that are not in use, hashed by name and dimensions, so
+// that GetCached does not walk m_cached. Each bucket is a free list: textures
+// are added by EraseCached and taken out again when GetCached reuses them.
+struct LegoCachedTextureIndex {
+	enum {
+		c_numBuckets = 64
+	};
+
+	// SIZE 0x0c
+	struct Entry {
+		LegoCachedTextureList::iterator m_cached; // 0x00
+		DWORD m_width;                            // 0x04
+		DWORD m_height;                           // 0x08
+	};
+
+	typedef vector<Entry> Bucket;
+
+	LegoCachedTextureIndex()
+	{
+		m_numHits = 0;
+		m_numMisses = 0;
+		m_numCreations = 0;
+	}
+
+	static LegoU32 Hash(const char* p_name, DWORD p_width, DWORD p_height)
+	{
+		LegoU32 hash = 2166136261u;
+
+		while (*p_name) {
+			hash = (hash ^ (LegoU8) *p_name++) * 16777619u;
+		}
+
+		hash = (hash ^ p_width) * 16777619u;
+		hash = (hash ^ p_height) * 16777619u;
+		return hash;
+	}
+
+	Bucket& GetBucket(const char* p_name, DWORD p_width, DWORD p_height)
+	{
+		return m_free[Hash(p_name, p_width, p_height) & (c_numBuckets - 1)];
+	}
+
+	void Remove(LegoTextureInfo* p_textureInfo, DWORD p_width, DWORD p_height)
+	{
+		Bucket& bucket = GetBucket(p_textureInfo->m_name, p_width, p_height);
+
+		for (LegoU32 i = 0; i < bucket.size(); i++) {
+			if ((*bucket[i].m_cached).first == p_textureInfo) {
+				bucket[i] = bucket.back();
+				bucket.pop_back();
+				return;
+			}
+		}
+	}
+
+	Bucket m_free[c_numBuckets];
+	LegoU32 m_numHits;
+	LegoU32 m_numMisses;
+	LegoU32 m_numCreations;
+};
+
+struct LegoCachedTextureIndexCompare {
+	LegoBool operator()(LegoTextureContainer* const& p_a, LegoTextureContainer* const& p_b) const { return p_a < p_b; }
+};
+
+typedef map<LegoTextureContainer*, LegoCachedTextureIndex*, LegoCachedTextureIndexCompare> LegoCachedTextureIndexMap;
+
+// The container has no room for its index in its layout
+static LegoCachedTextureIndexMap g_cachedTextureIndexes;
+
+static LegoCachedTextureIndex* GetCachedTextureIndex(LegoTextureContainer* p_container)
+{
+	LegoCachedTextureIndexMap::iterator it = g_cachedTextureIndexes.find(p_container);
+
+	if (it != g_cachedTextureIndexes.end()) {
+		return (*it).second;
+	}
+
+	LegoCachedTextureIndex* index = new LegoCachedTextureIndex;
+	g_cachedTextureIndexes[p_container] = index;
+	return index;
+}
+
+// Queries the dimensions through GetSurfaceDesc rather than by locking the
+// surface, which would stall on surfaces that are in use by the renderer
+static LegoBool GetCachedTextureSize(LegoTextureInfo* p_textureInfo, DWORD& p_width, DWORD& p_height)
+{
+	DDSURFACEDESC desc;
+	memset(&desc, 0, sizeof(desc));
+	desc.dwSize = sizeof(desc);
+
+	if (p_textureInfo->m_surface->GetSurfaceDesc(&desc) != DD_OK) {
+		return FALSE;
+	}
+
+	p_width = desc.dwWidth;
+	p_height = desc.dwHeight;
+	return TRUE;
+}
+
 // FUNCTION: LEGO1 0x10099870
 LegoTextureContainer::~LegoTextureContainer()
 {
+	LegoCachedTextureIndexMap::iterator it = g_cachedTextureIndexes.find(this);
+
+	if (it != g_cachedTextureIndexes.end()) {
+		delete (*it).second;
+		g_cachedTextureIndexes.erase(it);
+	}
 }
 
-// FUNCTION: LEGO1 0x100998e0
 LegoTextureInfo* LegoTextureContainer::GetCached(LegoTextureInfo* p_textureInfo)
 {
-	DDSURFACEDESC desc, newDesc;
+	DDSURFACEDESC newDesc;
 	DWORD width, height;
-	memset(&desc, 0, sizeof(desc));
-	desc.dwSize = sizeof(desc);
 
-	if (p_textureInfo->m_surface->Lock(NULL, &desc, DDLOCK_SURFACEMEMORYPTR, NULL) == DD_OK) {
-		width = desc.dwWidth;
-		height = desc.dwHeight;
-		p_textureInfo->m_surface->Unlock(desc.lpSurface);
+	if (!GetCachedTextureSize(p_textureInfo, width, height)) {
+		return NULL;
 	}
 
-	for (LegoCachedTextureList::iterator it = m_cached.begin(); it != m_cached.end(); it++) {
-		if ((*it).second == FALSE && (*it).first->m_texture->AddRef() != 0 && (*it).first->m_texture->Release() == 1) {
-			if (!strcmp((*it).first->m_name, p_textureInfo->m_name)) {
-				LPDIRECTDRAWSURFACE surface = (*it).first->m_surface;
-				memset(&newDesc, 0, sizeof(newDesc));
-				newDesc.dwSize = sizeof(newDesc);
-
-				if (surface->Lock(NULL, &newDesc, DDLOCK_SURFACEMEMORYPTR, NULL) == DD_OK) {
-					BOOL und = FALSE;
-					if (newDesc.dwWidth == width && newDesc.dwHeight == height) {
-						und = TRUE;
-					}
-
-					surface->Unlock(newDesc.lpSurface);
-
-					if (und) {
-						(*it).second = TRUE;
-						(*it).first->m_texture->AddRef();
-						return (*it).first;
-					}
-				}
-			}
+	LegoCachedTextureIndex* index = GetCachedTextureIndex(this);
+	LegoCachedTextureIndex::Bucket& bucket = index->GetBucket(p_textureInfo->m_name, width, height);
+
+	for (LegoU32 i = 0; i < bucket.size(); i++) {
+		LegoCachedTextureIndex::Entry& entry = bucket[i];
+
+		LegoTextureInfo* textureInfo = (*entry.m_cached).first;
+
+		// The bucket also holds textures of other names and dimensions with the same hash.
+		// A texture that is still referenced elsewhere stays in the free list for later.
+		if (entry.m_width == width && entry.m_height == height && !strcmp(textureInfo->m_name, p_textureInfo->m_name) &&
+			textureInfo->m_texture->AddRef() != 0 && textureInfo->m_texture->Release() == 1) {
+			(*entry.m_cached).second = TRUE;
+			entry = bucket.back();
+			bucket.pop_back();
+
+			index->m_numHits++;
+			textureInfo->m_texture->AddRef();
+			return textureInfo;
 		}
 	}
 
+	index->m_numMisses++;
+
 	LegoTextureInfo* textureInfo = new LegoTextureInfo();
 
 	textureInfo->m_palette = p_textureInfo->m_palette;
 	textureInfo->m_palette->AddRef();
 
 	memset(&newDesc, 0, sizeof(newDesc));
-	newDesc.dwWidth = desc.dwWidth;
-	newDesc.dwHeight = desc.dwHeight;
+	newDesc.dwWidth = width;
+	newDesc.dwHeight = height;
 	newDesc.dwSize = sizeof(newDesc);
 	newDesc.dwFlags = DDSD_PIXELFORMAT | DDSD_WIDTH | DDSD_HEIGHT | DDSD_CAPS;
 	newDesc.ddsCaps.dwCaps = DDCAPS_OVERLAYCANTCLIP | DDCAPS_OVERLAY;
-	newDesc.ddpfPixelFormat.dwSize = sizeof(desc.ddpfPixelFormat);
+	newDesc.ddpfPixelFormat.dwSize = sizeof(newDesc.ddpfPixelFormat);
 	newDesc.ddpfPixelFormat.dwFlags = DDPF_RGB | DDPF_PALETTEINDEXED8;
 	newDesc.ddpfPixelFormat.dwRGBBitCount = 8;
 
@@ -103,6 +204,8 @@ LegoTextureInfo* LegoTextureContainer::GetCached(LegoTextureInfo* p_textureInfo)
 
 				textureInfo->m_name = new char[strlen(p_textureInfo->m_name) + 1];
 				strcpy(textureInfo->m_name, p_textureInfo->m_name);
+
+				index->m_numCreations++;
 				return textureInfo;
 			}
 		}
@@ -125,14 +228,54 @@ void LegoTextureContainer::EraseCached(LegoTextureInfo* p_textureInfo)
 	for (LegoCachedTextureList::iterator it = m_cached.begin(); it != m_cached.end(); it++) {
 #endif
 		if ((*it).first == p_textureInfo) {
+			LegoCachedTextureIndex* index = GetCachedTextureIndex(this);
+			DWORD width, height;
+			LegoBool hasSize = GetCachedTextureSize(p_textureInfo, width, height);
+
+			// Erasing a texture that is not in use must not list it twice
+			if (hasSize) {
+				index->Remove(p_textureInfo, width, height);
+			}
+
 			(*it).second = FALSE;
 
 			if (p_textureInfo->m_texture->Release() == TRUE) {
 				delete p_textureInfo;
 				m_cached.erase(it);
 			}
+			else if (hasSize) {
+				LegoCachedTextureIndex::Entry entry;
+				entry.m_cached = it;
+				entry.m_width = width;
+				entry.m_height = height;
+				index->GetBucket(p_textureInfo->m_name, width, height).push_back(entry);
+			}
 
 			return;
 		}
 	}
 }
+
+LegoU32 LegoTextureContainer::GetNumCacheHits()
+{
+	return GetCachedTextureIndex(this)->m_numHits;
+}
+
+LegoU32 LegoTextureContainer::GetNumCacheMisses()
+{
+	return GetCachedTextureIndex(this)->m_numMisses;
+}
+
+LegoU32 LegoTextureContainer::GetNumCacheCreations()
+{
+	return GetCachedTextureIndex(this)->m_numCreations;
+}
+
+// Called by LegoWorld::Create, so that the statistics cover one world
+void LegoTextureContainer::ResetCacheStatistics()
+{
+	LegoCachedTextureIndex* index = GetCachedTextureIndex(this);
+	index->m_numHits = 0;
+	index->m_numMisses = 0;
+	index->m_numCreations = 0;
+}
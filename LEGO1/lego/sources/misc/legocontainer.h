@@ -122,6 +122,12 @@ class LegoTextureContainer : public LegoContainer<LegoTextureInfo> {
 	LegoTextureInfo* GetCached(LegoTextureInfo* p_textureInfo);
 	void EraseCached(LegoTextureInfo* p_textureInfo);
 
+	// Not part of the original game
+	LegoU32 GetNumCacheHits();
+	LegoU32 GetNumCacheMisses();
+	LegoU32 GetNumCacheCreations();
+	void ResetCacheStatistics();
+
 protected:
 	LegoCachedTextureList m_cached; // 0x18
 };
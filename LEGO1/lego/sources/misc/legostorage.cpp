@@ -8,6 +8,7 @@
 DECOMP_SIZE_ASSERT(LegoStorage, 0x08);
 DECOMP_SIZE_ASSERT(LegoMemory, 0x10);
 DECOMP_SIZE_ASSERT(LegoFile, 0x0c);
+DECOMP_SIZE_ASSERT(LegoMemoryBuffer, 0x18);
 
 // FUNCTION: LEGO1 0x10099080
 LegoMemory::LegoMemory(void* p_buffer) : LegoStorage()
@@ -126,3 +127,66 @@ LegoResult LegoFile::Open(const char* p_name, LegoU32 p_mode)
 	}
 	return SUCCESS;
 }
+
+LegoMemoryBuffer::LegoMemoryBuffer(LegoU32 p_mode) : LegoMemory(NULL)
+{
+	m_mode = p_mode;
+	m_size = 0;
+	m_capacity = 0;
+}
+
+LegoMemoryBuffer::~LegoMemoryBuffer()
+{
+	delete[] m_buffer;
+}
+
+LegoResult LegoMemoryBuffer::Read(void* p_buffer, LegoU32 p_size)
+{
+	if (m_position + p_size > m_size) {
+		return FAILURE;
+	}
+
+	return LegoMemory::Read(p_buffer, p_size);
+}
+
+LegoResult LegoMemoryBuffer::Write(const void* p_buffer, LegoU32 p_size)
+{
+	if (m_position + p_size > m_capacity) {
+		LegoU32 capacity = m_capacity ? m_capacity : 0x1000;
+
+		while (capacity < m_position + p_size) {
+			capacity *= 2;
+		}
+
+		LegoU8* buffer = new LegoU8[capacity];
+		if (buffer == NULL) {
+			return FAILURE;
+		}
+
+		if (m_buffer != NULL) {
+			memcpy(buffer, m_buffer, m_size);
+			delete[] m_buffer;
+		}
+
+		m_buffer = buffer;
+		m_capacity = capacity;
+	}
+
+	LegoMemory::Write(p_buffer, p_size);
+
+	if (m_position > m_size) {
+		m_size = m_position;
+	}
+
+	return SUCCESS;
+}
+
+LegoU8* LegoMemoryBuffer::Detach()
+{
+	LegoU8* buffer = m_buffer;
+	m_buffer = NULL;
+	m_position = 0;
+	m_size = 0;
+	m_capacity = 0;
+	return buffer;
+}
@@ -221,6 +221,28 @@ class LegoMemory : public LegoStorage {
 	LegoU32 m_position; // 0x08
 };
 
+// A LegoMemory that owns its buffer and grows it as it is written to.
+// Not part of the original game.
+// SIZE 0x18
+class LegoMemoryBuffer : public LegoMemory {
+public:
+	LegoMemoryBuffer(LegoU32 p_mode);
+	~LegoMemoryBuffer() override;
+
+	LegoResult Read(void* p_buffer, LegoU32 p_size) override;        // vtable+0x04
+	LegoResult Write(const void* p_buffer, LegoU32 p_size) override; // vtable+0x08
+
+	// Hands over the buffer, which then has to be deleted with delete[]
+	LegoU8* Detach();
+
+	LegoU8* GetBuffer() { return m_buffer; }
+	LegoU32 GetSize() { return m_size; }
+
+protected:
+	LegoU32 m_size;     // 0x10
+	LegoU32 m_capacity; // 0x14
+};
+
 // VTABLE: LEGO1 0x100db730
 // SIZE 0x0c
 class LegoFile : public LegoStorage {
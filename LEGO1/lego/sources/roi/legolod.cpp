@@ -18,6 +18,28 @@ LPDIRECT3DRMMATERIAL g_unk0x101013d4 = NULL;
 // GLOBAL: LEGO1 0x101013dc
 const char* g_unk0x101013dc = "inh";
 
+// Not part of the original game.
+// Scratch buffers for the temporary vertex and index arrays of LegoLOD::Read.
+// They only ever grow and are reused by all subsequent reads, so that loading
+// a part does not allocate and free five arrays per LOD.
+// The vertex buffer holds vertices, normals and texture vertices, which are shared
+// by all meshes of a LOD. The index buffer holds the indices of the current mesh.
+static LegoU8* g_lodVertexScratch = NULL;
+static LegoU32 g_lodVertexScratchSize = 0;
+static LegoU8* g_lodIndexScratch = NULL;
+static LegoU32 g_lodIndexScratchSize = 0;
+
+static LegoU8* ReserveScratch(LegoU8*& p_scratch, LegoU32& p_scratchSize, LegoU32 p_size)
+{
+	if (p_size > p_scratchSize) {
+		delete[] p_scratch;
+		p_scratch = new LegoU8[p_size];
+		p_scratchSize = p_size;
+	}
+
+	return p_scratch;
+}
+
 inline IDirect3DRM2* GetD3DRM(Tgl::Renderer* pRenderer);
 inline BOOL GetMeshData(IDirect3DRMMesh*& mesh, D3DRMGROUPINDEX& index, Tgl::Mesh* pMesh);
 
@@ -52,7 +74,19 @@ LegoLOD::~LegoLOD()
 	}
 }
 
-// FUNCTION: LEGO1 0x100aa510
+// Frees the scratch buffers of Read. Called by LegoOmni::Destroy.
+// Not part of the original game.
+void LegoLOD::FreeScratch()
+{
+	delete[] g_lodVertexScratch;
+	g_lodVertexScratch = NULL;
+	g_lodVertexScratchSize = 0;
+
+	delete[] g_lodIndexScratch;
+	g_lodIndexScratch = NULL;
+	g_lodIndexScratchSize = 0;
+}
+
 LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_textureContainer, LegoStorage* p_storage)
 {
 	float(*normals)[3] = NULL;
@@ -107,24 +141,35 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 		goto done;
 	}
 
-	if (numVerts > 0) {
-		vertices = new float[numVerts][sizeOfArray(*vertices)];
-		if (p_storage->Read(vertices, numVerts * sizeof(*vertices)) != SUCCESS) {
-			goto done;
+	{
+		LegoU32 verticesSize = numVerts > 0 ? numVerts * sizeof(*vertices) : 0;
+		LegoU32 normalsSize = numNormals > 0 ? numNormals * sizeof(*normals) : 0;
+		LegoU32 textureVerticesSize = numTextureVertices > 0 ? numTextureVertices * sizeof(*textureVertices) : 0;
+		LegoU8* scratch = ReserveScratch(
+			g_lodVertexScratch,
+			g_lodVertexScratchSize,
+			verticesSize + normalsSize + textureVerticesSize
+		);
+
+		if (verticesSize > 0) {
+			vertices = (float(*)[3]) scratch;
+			if (p_storage->Read(vertices, verticesSize) != SUCCESS) {
+				goto done;
+			}
 		}
-	}
 
-	if (numNormals > 0) {
-		normals = new float[numNormals][sizeOfArray(*normals)];
-		if (p_storage->Read(normals, numNormals * sizeof(*normals)) != SUCCESS) {
-			goto done;
+		if (normalsSize > 0) {
+			normals = (float(*)[3]) (scratch + verticesSize);
+			if (p_storage->Read(normals, normalsSize) != SUCCESS) {
+				goto done;
+			}
 		}
-	}
 
-	if (numTextureVertices > 0) {
-		textureVertices = new float[numTextureVertices][sizeOfArray(*textureVertices)];
-		if (p_storage->Read(textureVertices, numTextureVertices * sizeof(*textureVertices)) != SUCCESS) {
-			goto done;
+		if (textureVerticesSize > 0) {
+			textureVertices = (float(*)[2]) (scratch + verticesSize + normalsSize);
+			if (p_storage->Read(textureVertices, textureVerticesSize) != SUCCESS) {
+				goto done;
+			}
 		}
 	}
 
@@ -143,7 +188,12 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 			goto done;
 		}
 
-		polyIndices = new LegoU32[numPolys & USHRT_MAX][sizeOfArray(*polyIndices)];
+		// Room for both the polygon indices and the texture indices of this mesh
+		polyIndices = (LegoU32(*)[3]) ReserveScratch(
+			g_lodIndexScratch,
+			g_lodIndexScratchSize,
+			2 * (numPolys & USHRT_MAX) * sizeof(*polyIndices)
+		);
 		if (p_storage->Read(polyIndices, (numPolys & USHRT_MAX) * sizeof(*polyIndices)) != SUCCESS) {
 			goto done;
 		}
@@ -153,7 +203,7 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 		}
 
 		if (numTextureIndices > 0) {
-			textureIndices = new LegoU32[numPolys & USHRT_MAX][sizeOfArray(*textureIndices)];
+			textureIndices = polyIndices + (numPolys & USHRT_MAX);
 			if (p_storage->Read(textureIndices, (numPolys & USHRT_MAX) * sizeof(*textureIndices)) != SUCCESS) {
 				goto done;
 			}
@@ -255,49 +305,15 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 			delete mesh;
 			mesh = NULL;
 		}
-		if (polyIndices != NULL) {
-			delete[] polyIndices;
-			polyIndices = NULL;
-		}
-		if (textureIndices != NULL) {
-			delete[] textureIndices;
-			textureIndices = NULL;
-		}
 	}
 
 	m_unk0x1c = meshUnd2;
-
-	if (textureVertices != NULL) {
-		delete[] textureVertices;
-	}
-	if (normals != NULL) {
-		delete[] normals;
-	}
-	if (vertices != NULL) {
-		delete[] vertices;
-	}
-
 	return SUCCESS;
 
 done:
-	if (normals != NULL) {
-		delete[] normals;
-	}
-	if (vertices != NULL) {
-		delete[] vertices;
-	}
-	if (textureVertices != NULL) {
-		delete[] textureVertices;
-	}
 	if (mesh != NULL) {
 		delete mesh;
 	}
-	if (polyIndices != NULL) {
-		delete[] polyIndices;
-	}
-	if (textureIndices != NULL) {
-		delete[] textureIndices;
-	}
 
 	return FAILURE;
 }
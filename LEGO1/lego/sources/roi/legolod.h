@@ -36,6 +36,7 @@ class LegoLOD : public ViewLOD {
 	LegoResult GetTexture(LegoTextureInfo*& p_textureInfo);
 
 	static LegoBool FUN_100aae20(const LegoChar* p_name);
+	static void FreeScratch();
 
 	// SYNTHETIC: LEGO1 0x100aa430
 	// LegoLOD::`scalar deleting destructor'
@@ -1,11 +1,23 @@
 #include "modeldb.h"
 
+#include <sys/stat.h>
+#include <sys/types.h>
+
 DECOMP_SIZE_ASSERT(ModelDbWorld, 0x18)
 DECOMP_SIZE_ASSERT(ModelDbPart, 0x18)
 DECOMP_SIZE_ASSERT(ModelDbModel, 0x38)
 DECOMP_SIZE_ASSERT(ModelDbPartList, 0x1c)
 DECOMP_SIZE_ASSERT(ModelDbPartListCursor, 0x10)
 
+// Not part of the original game.
+// The world.wdb directory does not change while the game is running,
+// so it is parsed once and shared by every call to LoadWorld.
+static ModelDbWorld* g_modelDbWorlds = NULL;
+static MxS32 g_modelDbNumWorlds = 0;
+static MxLong g_modelDbFileSize = 0;
+static time_t g_modelDbFileTime = 0;
+static MxLong g_modelDbDirectoryEnd = 0;
+
 // FUNCTION: LEGO1 0x10027690
 // FUNCTION: BETA10 0x100e5620
 void ModelDbModel::Free()
@@ -173,3 +185,59 @@ void FreeModelDbWorlds(ModelDbWorld*& p_worlds, MxS32 p_numWorlds)
 	delete[] p_worlds;
 	p_worlds = NULL;
 }
+
+// Returns the parsed directory of p_file, reading it only if it has not been cached yet
+// (or if the file size or modification time differ from the cached one). On success, the file is positioned
+// right after the directory, as it would be after ReadModelDbWorlds.
+// The returned worlds are owned by the cache and must not be freed by the caller.
+MxResult ReadCachedModelDbWorlds(FILE* p_file, ModelDbWorld*& p_worlds, MxS32& p_numWorlds)
+{
+	p_worlds = NULL;
+	p_numWorlds = 0;
+
+	struct _stat status;
+
+	if (_fstat(_fileno(p_file), &status) != 0) {
+		return FAILURE;
+	}
+
+	MxLong fileSize = status.st_size;
+	time_t fileTime = status.st_mtime;
+
+	if (g_modelDbWorlds != NULL && g_modelDbFileSize == fileSize && g_modelDbFileTime == fileTime) {
+		if (fseek(p_file, g_modelDbDirectoryEnd, SEEK_SET) != 0) {
+			return FAILURE;
+		}
+	}
+	else {
+		FreeCachedModelDbWorlds();
+
+		if (fseek(p_file, 0, SEEK_SET) != 0) {
+			return FAILURE;
+		}
+
+		if (ReadModelDbWorlds(p_file, g_modelDbWorlds, g_modelDbNumWorlds) != SUCCESS) {
+			return FAILURE;
+		}
+
+		g_modelDbFileSize = fileSize;
+		g_modelDbFileTime = fileTime;
+		g_modelDbDirectoryEnd = ftell(p_file);
+	}
+
+	p_worlds = g_modelDbWorlds;
+	p_numWorlds = g_modelDbNumWorlds;
+	return SUCCESS;
+}
+
+void FreeCachedModelDbWorlds()
+{
+	if (g_modelDbWorlds != NULL) {
+		FreeModelDbWorlds(g_modelDbWorlds, g_modelDbNumWorlds);
+	}
+
+	g_modelDbNumWorlds = 0;
+	g_modelDbFileSize = 0;
+	g_modelDbFileTime = 0;
+	g_modelDbDirectoryEnd = 0;
+}
@@ -115,5 +115,7 @@ struct ModelDbWorld {
 
 MxResult ReadModelDbWorlds(FILE* p_file, ModelDbWorld*& p_worlds, MxS32& p_numWorlds);
 void FreeModelDbWorlds(ModelDbWorld*& p_worlds, MxS32 p_numWorlds);
+MxResult ReadCachedModelDbWorlds(FILE* p_file, ModelDbWorld*& p_worlds, MxS32& p_numWorlds);
+void FreeCachedModelDbWorlds();
 
 #endif // MODELDB_H
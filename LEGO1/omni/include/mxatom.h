@@ -57,6 +57,65 @@ enum LookupMode {
 	e_lowerCase2,
 };
 
+// Finds atoms by a hash of their key instead of the ordered lookup in
+// MxAtomSet, which needed a temporary MxAtom holding a copy of the string.
+// The case of the lookup mode is folded while hashing and comparing, so no
+// folded copy is made either. Keys that already belong to an atom, as held by
+// every MxAtomId, are found by their address without looking at the string.
+// The set still owns the atoms; MxOmni::Destroy clears the index along with it.
+// If the index cannot grow, the atoms added afterwards are only in the set, and
+// lookups that miss fall back to searching the set.
+// Not part of the original game.
+// SIZE 0x20
+class MxAtomIndex {
+public:
+	MxAtomIndex();
+
+	static MxAtomIndex* GetInstance();
+
+	MxAtom* Find(const char* p_str, LookupMode p_mode);
+	MxAtom* FindByKey(const char* p_key);
+	MxResult Add(MxAtom* p_atom);
+	void Clear();
+
+	MxBool IsComplete() { return m_complete; }
+
+	MxU32 GetNumAtoms() { return m_numAtoms; }
+	MxU32 GetNumLookups() { return m_numLookups; }
+	MxU32 GetNumKeyHits() { return m_numKeyHits; }
+	MxU32 GetNumProbes() { return m_numProbes; }
+
+	void ResetStatistics()
+	{
+		m_numLookups = 0;
+		m_numKeyHits = 0;
+		m_numProbes = 0;
+	}
+
+private:
+	// SIZE 0x08
+	struct Entry {
+		MxU32 m_hash;   // 0x00
+		MxAtom* m_atom; // 0x04
+	};
+
+	static MxU32 Hash(const char* p_str, LookupMode p_mode);
+	static MxU32 HashKey(const char* p_key);
+	static MxBool Matches(const char* p_key, const char* p_str, LookupMode p_mode);
+
+	MxResult Grow();
+	void Insert(MxU32 p_hash, MxAtom* p_atom);
+
+	Entry* m_entries;   // 0x00
+	MxAtom** m_keys;    // 0x04
+	MxU32 m_capacity;   // 0x08
+	MxU32 m_numAtoms;   // 0x0c
+	MxU32 m_numLookups; // 0x10
+	MxU32 m_numKeyHits; // 0x14
+	MxU32 m_numProbes;  // 0x18
+	MxBool m_complete;  // 0x1c
+};
+
 // SIZE 0x04
 class MxAtomId {
 public:
@@ -0,0 +1,173 @@
+#ifndef MXAUDIOMIXER_H
+#define MXAUDIOMIXER_H
+
+#include "decomp.h"
+#include "mxcore.h"
+#include "mxcriticalsection.h"
+#include "mxstl/stlcompat.h"
+#include "mxtypes.h"
+
+#include <dsound.h>
+
+class MxAudioMixer;
+class MxAudioOutput;
+class MxTickleThread;
+
+// A sound buffer that is played by MxAudioMixer instead of by DirectSound.
+// It implements IDirectSoundBuffer, so the presenters and cache sounds can keep
+// streaming into it and controlling it exactly like a hardware buffer.
+// Not part of the original game.
+// SIZE 0x48
+class MxMixerVoice : public IDirectSoundBuffer {
+public:
+	MxMixerVoice(MxAudioMixer* p_mixer);
+	virtual ~MxMixerVoice();
+
+	MxResult Create(LPCDSBUFFERDESC p_desc);
+	void Duplicate(MxMixerVoice* p_source);
+
+	STDMETHOD(QueryInterface)(REFIID p_iid, LPVOID* p_object);
+	STDMETHOD_(ULONG, AddRef)();
+	STDMETHOD_(ULONG, Release)();
+
+	STDMETHOD(GetCaps)(LPDSBCAPS p_caps);
+	STDMETHOD(GetCurrentPosition)(LPDWORD p_playCursor, LPDWORD p_writeCursor);
+	STDMETHOD(GetFormat)(LPWAVEFORMATEX p_format, DWORD p_size, LPDWORD p_sizeWritten);
+	STDMETHOD(GetVolume)(LPLONG p_volume);
+	STDMETHOD(GetPan)(LPLONG p_pan);
+	STDMETHOD(GetFrequency)(LPDWORD p_frequency);
+	STDMETHOD(GetStatus)(LPDWORD p_status);
+	STDMETHOD(Initialize)(LPDIRECTSOUND p_directSound, LPCDSBUFFERDESC p_desc);
+	STDMETHOD(Lock)(
+		DWORD p_offset,
+		DWORD p_bytes,
+		LPVOID* p_audioPtr1,
+		LPDWORD p_audioBytes1,
+		LPVOID* p_audioPtr2,
+		LPDWORD p_audioBytes2,
+		DWORD p_flags
+	);
+	STDMETHOD(Play)(DWORD p_reserved1, DWORD p_reserved2, DWORD p_flags);
+	STDMETHOD(SetCurrentPosition)(DWORD p_position);
+	STDMETHOD(SetFormat)(LPCWAVEFORMATEX p_format);
+	STDMETHOD(SetVolume)(LONG p_volume);
+	STDMETHOD(SetPan)(LONG p_pan);
+	STDMETHOD(SetFrequency)(DWORD p_frequency);
+	STDMETHOD(Stop)();
+	STDMETHOD(Unlock)(LPVOID p_audioPtr1, DWORD p_audioBytes1, LPVOID p_audioPtr2, DWORD p_audioBytes2);
+	STDMETHOD(Restore)();
+
+	// Called by the mixer with the lock held
+	void Mix(MxS32* p_accumulator, MxU32 p_frames, MxU16 p_channels, MxU32 p_sampleRate);
+	void Skip(MxU32 p_frames, MxU32 p_sampleRate);
+
+	void Detach() { m_mixer = NULL; }
+	MxBool IsPlaying() { return m_playing; }
+	MxS32 GetLoudness() { return m_targetLeft > m_targetRight ? m_targetLeft : m_targetRight; }
+
+private:
+	void Enter();
+	void Leave();
+	void UpdateGains();
+	MxBool Advance(MxU32 p_step, MxU32 p_numFrames);
+
+	MxS32 ReadSample(MxU32 p_frame, MxU32 p_channel)
+	{
+		if (m_bitsPerSample == 16) {
+			return ((MxS16*) m_data)[p_frame * m_channels + p_channel];
+		}
+
+		return ((MxS32) m_data[p_frame * m_channels + p_channel] - 0x80) << 8;
+	}
+
+	LONG m_refCount;       // 0x04
+	MxAudioMixer* m_mixer; // 0x08
+	MxU8* m_data;          // 0x0c
+	MxU32 m_dataSize;      // 0x10
+	MxU32 m_flags;         // 0x14
+	MxU32 m_sampleRate;    // 0x18
+	MxU32 m_frequency;     // 0x1c
+	MxU16 m_channels;      // 0x20
+	MxU16 m_bitsPerSample; // 0x22
+	MxU16 m_blockAlign;    // 0x24
+	MxBool m_playing;      // 0x26
+	MxBool m_looping;      // 0x27
+	LONG m_volume;         // 0x28
+	LONG m_pan;            // 0x2c
+	MxU32 m_position;      // 0x30
+	MxU32 m_fraction;      // 0x34
+	MxS32 m_gainLeft;      // 0x38
+	MxS32 m_gainRight;     // 0x3c
+	MxS32 m_targetLeft;    // 0x40
+	MxS32 m_targetRight;   // 0x44
+};
+
+// Mixes all sounds in software into a single 16-bit output, instead of giving
+// every sound its own DirectSound buffer. Each voice is resampled to the output
+// rate with linear interpolation, and its volume and pan are ramped over a few
+// milliseconds to avoid clicks. If more voices play than can be mixed, the
+// quietest ones keep advancing silently until they are loud enough again.
+// The output is pulled by a tickle thread, see MxAudioOutput for the backends.
+// Not part of the original game.
+// SIZE 0x50
+class MxAudioMixer : public MxCore {
+public:
+	enum {
+		c_maxMixedVoices = 24,
+		c_blockFrames = 512,
+		c_gainShift = 14,
+		c_unityGain = 1 << c_gainShift,
+		c_rampFrames = 64
+	};
+
+	MxAudioMixer();
+	~MxAudioMixer() override;
+
+	MxResult Tickle() override; // vtable+0x08
+
+	const char* ClassName() const override // vtable+0x0c
+	{
+		return "MxAudioMixer";
+	}
+
+	MxBool IsA(const char* p_name) const override // vtable+0x10
+	{
+		return !strcmp(p_name, MxAudioMixer::ClassName()) || MxCore::IsA(p_name);
+	}
+
+	MxResult Create(MxAudioOutput* p_output, MxU32 p_sampleRate, MxU16 p_channels, MxS32 p_frequencyMS);
+	void Destroy();
+
+	MxResult CreateVoice(LPCDSBUFFERDESC p_desc, LPDIRECTSOUNDBUFFER* p_buffer);
+	MxResult DuplicateVoice(LPDIRECTSOUNDBUFFER p_source, LPDIRECTSOUNDBUFFER* p_buffer);
+	void RemoveVoice(MxMixerVoice* p_voice);
+	void Mix(MxS16* p_samples, MxU32 p_frames);
+
+	static MxCriticalSection& GetLock();
+	MxU32 GetSampleRate() { return m_sampleRate; }
+	MxU16 GetChannels() { return m_channels; }
+	MxU32 GetNumVoices() { return m_voices.size(); }
+	MxU32 GetNumMixedVoices() { return m_numMixedVoices; }
+	MxU32 GetFramesMixed() { return m_framesMixed; }
+	double GetMixSeconds() { return m_mixSeconds; }
+
+private:
+	typedef vector<MxMixerVoice*> MxMixerVoiceVector;
+
+	void SelectVoices();
+	void MixBlock(MxS16* p_samples, MxU32 p_frames);
+
+	MxAudioOutput* m_output;      // 0x08
+	MxTickleThread* m_thread;     // 0x0c
+	MxMixerVoiceVector m_voices;  // 0x10
+	MxMixerVoiceVector m_playing; // 0x20
+	MxS32* m_accumulator;         // 0x30
+	MxS16* m_samples;             // 0x34
+	MxU32 m_sampleRate;           // 0x38
+	MxU16 m_channels;             // 0x3c
+	MxU32 m_numMixedVoices;       // 0x40
+	MxU32 m_framesMixed;          // 0x44
+	double m_mixSeconds;          // 0x48
+};
+
+#endif // MXAUDIOMIXER_H
@@ -0,0 +1,104 @@
+#ifndef MXAUDIOOUTPUT_H
+#define MXAUDIOOUTPUT_H
+
+#include "decomp.h"
+#include "mxtypes.h"
+
+#include <dsound.h>
+#include <stdio.h>
+
+// The device the software mixer writes its 16-bit output to.
+// Not part of the original game.
+// SIZE 0x0c
+class MxAudioOutput {
+public:
+	MxAudioOutput()
+	{
+		m_sampleRate = 0;
+		m_channels = 0;
+	}
+	virtual ~MxAudioOutput() {}
+
+	virtual MxResult Open(MxU32 p_sampleRate, MxU16 p_channels) = 0;
+	virtual void Close() = 0;
+
+	// Returns the number of frames that can be written without blocking
+	virtual MxU32 GetWritableFrames() = 0;
+	virtual MxResult Write(const MxS16* p_samples, MxU32 p_frames) = 0;
+
+	MxU32 GetSampleRate() { return m_sampleRate; }
+	MxU16 GetChannels() { return m_channels; }
+
+protected:
+	MxU32 m_sampleRate; // 0x04
+	MxU16 m_channels;   // 0x08
+};
+
+// Streams the mixed output through a single looping DirectSound buffer.
+// Not part of the original game.
+// SIZE 0x24
+class MxDirectSoundAudioOutput : public MxAudioOutput {
+public:
+	enum {
+		c_bufferMS = 250,
+		c_latencyMS = 80
+	};
+
+	MxDirectSoundAudioOutput();
+	~MxDirectSoundAudioOutput() override;
+
+	MxResult Open(MxU32 p_sampleRate, MxU16 p_channels) override;
+	void Close() override;
+	MxU32 GetWritableFrames() override;
+	MxResult Write(const MxS16* p_samples, MxU32 p_frames) override;
+
+private:
+	LPDIRECTSOUND m_directSound;         // 0x0c
+	LPDIRECTSOUNDBUFFER m_primaryBuffer; // 0x10
+	LPDIRECTSOUNDBUFFER m_buffer;        // 0x14
+	MxU32 m_bufferSize;                  // 0x18
+	MxU32 m_writeOffset;                 // 0x1c
+	MxU32 m_latency;                     // 0x20
+};
+
+// Discards the mixed output, accepting it at the rate a real device would.
+// Useful to run and measure the mixer without any sound hardware.
+// Not part of the original game.
+// SIZE 0x18
+class MxNullAudioOutput : public MxAudioOutput {
+public:
+	MxNullAudioOutput();
+
+	MxResult Open(MxU32 p_sampleRate, MxU16 p_channels) override;
+	void Close() override;
+	MxU32 GetWritableFrames() override;
+	MxResult Write(const MxS16* p_samples, MxU32 p_frames) override;
+
+	MxU32 GetFramesWritten() { return m_framesWritten; }
+
+protected:
+	MxULong m_lastTime;    // 0x0c
+	MxU32 m_remainder;     // 0x10
+	MxU32 m_framesWritten; // 0x14
+};
+
+// Records the mixed output to a PCM WAV file.
+// Not part of the original game.
+// SIZE 0x20
+class MxWaveFileAudioOutput : public MxNullAudioOutput {
+public:
+	MxWaveFileAudioOutput(const char* p_path);
+	~MxWaveFileAudioOutput() override;
+
+	MxResult Open(MxU32 p_sampleRate, MxU16 p_channels) override;
+	void Close() override;
+	MxResult Write(const MxS16* p_samples, MxU32 p_frames) override;
+
+private:
+	void WriteHeader();
+
+	FILE* m_file;     // 0x18
+	MxU32 m_dataSize; // 0x1c
+};
+
+#endif // MXAUDIOOUTPUT_H
@@ -0,0 +1,37 @@
+#ifndef MXCLOCK_H
+#define MXCLOCK_H
+
+#include "mxtypes.h"
+
+#include <windows.h>
+
+typedef MxS64 (*MxClockProc)();
+
+// A monotonic high resolution clock. Falls back to timeGetTime if there is no
+// performance counter.
+// Not part of the original game.
+class MxClock {
+public:
+	// Returns the time in microseconds since an arbitrary point
+	static MxS64 GetMicroseconds()
+	{
+		static MxS64 g_frequency = 0;
+
+		if (g_frequency == 0) {
+			LARGE_INTEGER frequency;
+			g_frequency = QueryPerformanceFrequency(&frequency) ? frequency.QuadPart : -1;
+		}
+
+		if (g_frequency < 0) {
+			return (MxS64) timeGetTime() * 1000;
+		}
+
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter(&counter);
+
+		// Split the conversion, multiplying the raw counter by a million could overflow
+		return counter.QuadPart / g_frequency * 1000000 + counter.QuadPart % g_frequency * 1000000 / g_frequency;
+	}
+};
+
+#endif // MXCLOCK_H
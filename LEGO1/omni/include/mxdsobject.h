@@ -53,6 +53,10 @@ class MxDSObject : public MxCore {
 	void SetObjectName(const char* p_objectName);
 	void SetSourceName(const char* p_sourceName);
 
+	// Not part of the original game. See MxDSObjectPool.
+	static void* operator new(size_t p_size);
+	static void operator delete(void* p_memory);
+
 	// FUNCTION: LEGO1 0x100bf730
 	// FUNCTION: BETA10 0x1012bdd0
 	const char* ClassName() const override { return "MxDSObject"; } // vtable+0c
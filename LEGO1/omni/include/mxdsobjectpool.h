@@ -0,0 +1,68 @@
+#ifndef MXDSOBJECTPOOL_H
+#define MXDSOBJECTPOOL_H
+
+#include "decomp.h"
+#include "mxcriticalsection.h"
+#include "mxtypes.h"
+
+#include <stddef.h>
+
+// Allocates MxDSObjects out of large blocks, with a free list per size class.
+// Deserializing an SI file creates a node for every action and every node is
+// deleted again on world exit, which used to cost a heap allocation and a free
+// per node. Freed nodes go back to their free list and are reused by the next
+// tree, so after the first world the blocks are rarely extended. Objects larger
+// than the largest size class come from the heap. The pool can be disabled,
+// which only affects objects allocated afterwards.
+// Not part of the original game.
+// SIZE 0x6c
+class MxDSObjectPool {
+public:
+	enum {
+		c_granularity = 16,
+		c_numSizeClasses = 12,
+		c_blockSize = 0x8000
+	};
+
+	MxDSObjectPool();
+
+	static MxDSObjectPool* GetInstance();
+
+	void* Allocate(size_t p_size);
+	void Free(void* p_memory);
+
+	void SetEnabled(MxBool p_enabled) { m_enabled = p_enabled; }
+
+	MxU32 GetNumLive() { return m_numLive; }
+	MxU32 GetNumReused() { return m_numReused; }
+	MxU32 GetNumFromHeap() { return m_numFromHeap; }
+	MxU32 GetBytesLive() { return m_bytesLive; }
+	MxU32 GetBytesReserved() { return m_bytesReserved; }
+
+private:
+	// Precedes every object, keeping it 8-byte aligned
+	// SIZE 0x08
+	struct Header {
+		MxS32 m_sizeClass; // 0x00
+		MxU32 m_size;      // 0x04
+	};
+
+	// Stored in place of a free object
+	// SIZE 0x04
+	struct FreeNode {
+		FreeNode* m_next; // 0x00
+	};
+
+	MxCriticalSection m_lock;                // 0x00
+	FreeNode* m_freeLists[c_numSizeClasses]; // 0x1c
+	MxU8* m_block;                           // 0x4c
+	MxU32 m_blockUsed;                       // 0x50
+	MxBool m_enabled;                        // 0x54
+	MxU32 m_numLive;                         // 0x58
+	MxU32 m_numReused;                       // 0x5c
+	MxU32 m_numFromHeap;                     // 0x60
+	MxU32 m_bytesLive;                       // 0x64
+	MxU32 m_bytesReserved;                   // 0x68
+};
+
+#endif // MXDSOBJECTPOOL_H
@@ -34,12 +34,30 @@ class MxDSSelectAction : public MxDSParallelAction {
 	void Deserialize(MxU8*& p_source, MxS16 p_unk0x24) override; // vtable+1c;
 	MxDSAction* Clone() override;                                // vtable+2c;
 
+	// Not part of the original game
+	static MxU32 GetNumParsed() { return g_numParsed; }
+	static MxU32 GetNumSkipped() { return g_numSkipped; }
+	static MxU32 GetBytesSkipped() { return g_bytesSkipped; }
+	static double GetParseSeconds() { return g_parseSeconds; }
+	static void ResetStatistics()
+	{
+		g_numParsed = 0;
+		g_numSkipped = 0;
+		g_bytesSkipped = 0;
+		g_parseSeconds = 0.0;
+	}
+
 	// SYNTHETIC: LEGO1 0x100cb840
 	// MxDSSelectAction::`scalar deleting destructor'
 
 private:
 	MxString m_unk0x9c;
 	MxStringList* m_unk0xac;
+
+	static MxU32 g_numParsed;
+	static MxU32 g_numSkipped;
+	static MxU32 g_bytesSkipped;
+	static double g_parseSeconds;
 };
 
 // SYNTHETIC: LEGO1 0x100cbbd0
@@ -0,0 +1,55 @@
+#ifndef MXDSSTRINGTABLE_H
+#define MXDSSTRINGTABLE_H
+
+#include "decomp.h"
+#include "mxcriticalsection.h"
+#include "mxtypes.h"
+
+#include <stddef.h>
+
+// Shares the source and object names of MxDSObjects. The actions of an SI file
+// repeat the same few source names, and every clone of an action used to copy
+// its names again. Each distinct name is stored once with a reference count and
+// freed with its last user. The returned strings must not be modified.
+// Not part of the original game.
+// SIZE 0x42c
+class MxDSStringTable {
+public:
+	enum {
+		c_numBuckets = 256
+	};
+
+	MxDSStringTable();
+
+	static MxDSStringTable* GetInstance();
+
+	const char* Acquire(const char* p_string);
+	void Release(const char* p_string);
+
+	MxU32 GetNumStrings() { return m_numStrings; }
+	MxU32 GetNumReferences() { return m_numReferences; }
+	MxU32 GetBytesStored() { return m_bytesStored; }
+	MxU32 GetBytesShared() { return m_bytesShared; }
+
+private:
+	// SIZE 0x14
+	struct Entry {
+		Entry* m_next;    // 0x00
+		MxU32 m_hash;     // 0x04
+		MxU32 m_refCount; // 0x08
+		MxU32 m_length;   // 0x0c
+		char m_string[4]; // 0x10
+	};
+
+	static MxU32 Hash(const char* p_string, MxU32& p_length);
+	static Entry* GetEntry(const char* p_string) { return (Entry*) (p_string - offsetof(Entry, m_string)); }
+
+	MxCriticalSection m_lock;       // 0x000
+	Entry* m_buckets[c_numBuckets]; // 0x01c
+	MxU32 m_numStrings;             // 0x41c
+	MxU32 m_numReferences;          // 0x420
+	MxU32 m_bytesStored;            // 0x424
+	MxU32 m_bytesShared;            // 0x428
+};
+
+#endif // MXDSSTRINGTABLE_H
@@ -0,0 +1,72 @@
+#ifndef MXFLCFRAMECACHE_H
+#define MXFLCFRAMECACHE_H
+
+#include "decomp.h"
+#include "mxstl/stlcompat.h"
+#include "mxtypes.h"
+
+#include <windows.h>
+
+class MxBitmap;
+class MxStreamChunk;
+
+// Keeps the decoded frames of a looping FLIC animation, keyed by the looping
+// chunk they were decoded from. Each pass of the loop presents the same chunks
+// in the same order, so from the second pass on a cached frame can be copied
+// into the presenter's bitmap instead of being decoded again.
+// All caches share one memory budget. Frames that do not fit are decoded as usual,
+// which is always possible since the bitmap holds the previous frame.
+// Not part of the original game.
+// SIZE 0x20
+class MxFlcFrameCache {
+public:
+	// SIZE 0x20
+	struct Frame {
+		MxU8* m_chunkData;        // 0x00
+		MxU32 m_chunkLength;      // 0x04
+		MxU8* m_image;            // 0x08
+		MxU32 m_imageSize;        // 0x0c
+		RGBQUAD* m_palette;       // 0x10
+		MxBool m_decodedColorMap; // 0x14
+		double m_decodeSeconds;   // 0x18
+	};
+
+	MxFlcFrameCache();
+	~MxFlcFrameCache();
+
+	MxBool Restore(MxStreamChunk* p_chunk, MxBitmap* p_bitmap, MxBool& p_decodedColorMap);
+	void Store(MxStreamChunk* p_chunk, MxBitmap* p_bitmap, MxBool p_decodedColorMap, double p_decodeSeconds);
+	void Clear();
+
+	MxU32 GetNumFrames() { return m_frames.size(); }
+	MxU32 GetNumHits() { return m_numHits; }
+	double GetSecondsSaved() { return m_secondsSaved; }
+
+	static void SetMemoryBudget(MxU32 p_memoryBudget) { g_memoryBudget = p_memoryBudget; }
+	static MxU32 GetMemoryBudget() { return g_memoryBudget; }
+	static MxU32 GetMemoryUsed() { return g_memoryUsed; }
+
+private:
+	struct FrameCompare {
+		MxBool operator()(MxStreamChunk* const& p_a, MxStreamChunk* const& p_b) const { return p_a < p_b; }
+	};
+
+	typedef map<MxStreamChunk*, Frame, FrameCompare> FrameMap;
+
+	void Erase(FrameMap::iterator p_it);
+
+	static MxU32 FrameSize(MxU32 p_imageSize, MxBool p_hasPalette)
+	{
+		return p_hasPalette ? p_imageSize + sizeof(RGBQUAD) * 256 : p_imageSize;
+	}
+
+	FrameMap m_frames;     // 0x00
+	MxU32 m_memoryUsed;    // 0x10
+	MxU32 m_numHits;       // 0x14
+	double m_secondsSaved; // 0x18
+
+	static MxU32 g_memoryBudget;
+	static MxU32 g_memoryUsed;
+};
+
+#endif // MXFLCFRAMECACHE_H
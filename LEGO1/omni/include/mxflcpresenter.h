@@ -34,6 +34,9 @@ class MxFlcPresenter : public MxVideoPresenter {
 		return HandlerClassName();
 	}
 
+	// Not part of the original game, frees the frame cache
+	void Destroy() override; // vtable+0x38
+
 	void LoadHeader(MxStreamChunk* p_chunk) override; // vtable+0x5c
 	void CreateBitmap() override;                     // vtable+0x60
 	void LoadFrame(MxStreamChunk* p_chunk) override;  // vtable+0x68
@@ -0,0 +1,126 @@
+#ifndef MXFRAMEPACER_H
+#define MXFRAMEPACER_H
+
+#include "mxclock.h"
+#include "mxtypes.h"
+
+#include <string.h>
+#include <windows.h>
+
+// Decides when the next frame is due and waits for it without busy polling.
+// Frames are scheduled on a fixed grid of the frame delta, so an early or late
+// frame does not shift the ones after it. Waiting sleeps for most of the
+// remaining time and spins only for the last stretch, since Sleep is not precise.
+// The time between frames is recorded in a histogram, see GetPercentile.
+// The clock can be replaced, e.g. by a fake one to run the loop deterministically.
+// Not part of the original game.
+// SIZE 0x228
+class MxFramePacer {
+public:
+	enum {
+		c_spinMicroseconds = 1500,
+		c_bucketMicroseconds = 250,
+		c_numBuckets = 128
+	};
+
+	MxFramePacer()
+	{
+		m_clockProc = MxClock::GetMicroseconds;
+		m_frameDelta = 10000;
+		m_nextFrameTime = 0;
+		m_lastFrameTime = -1;
+		ResetStatistics();
+
+		// Lets Sleep wake up within a millisecond
+		timeBeginPeriod(1);
+	}
+
+	~MxFramePacer() { timeEndPeriod(1); }
+
+	void SetClockProc(MxClockProc p_clockProc) { m_clockProc = p_clockProc; }
+	void SetFrameDelta(MxLong p_milliseconds) { m_frameDelta = (MxS64) p_milliseconds * 1000; }
+
+	MxBool IsFrameDue() { return m_clockProc() >= m_nextFrameTime; }
+
+	// Called when a due frame starts
+	void BeginFrame()
+	{
+		MxS64 time = m_clockProc();
+
+		if (m_lastFrameTime >= 0) {
+			MxS64 bucket = (time - m_lastFrameTime) / c_bucketMicroseconds;
+			m_histogram[bucket < c_numBuckets ? bucket : c_numBuckets - 1]++;
+			m_numFrames++;
+		}
+
+		m_lastFrameTime = time;
+		m_nextFrameTime += m_frameDelta;
+
+		// Fell behind by more than a frame, don't try to catch up
+		if (m_nextFrameTime <= time) {
+			m_nextFrameTime = time + m_frameDelta;
+		}
+	}
+
+	// Waits until the next frame is due. With p_wakeOnMessage, returns early
+	// when a window message arrives.
+	void WaitForFrame(MxBool p_wakeOnMessage)
+	{
+		MxS64 remaining = m_nextFrameTime - m_clockProc();
+
+		if (remaining > c_spinMicroseconds) {
+			DWORD milliseconds = (DWORD) ((remaining - c_spinMicroseconds) / 1000);
+
+			if (p_wakeOnMessage) {
+				if (MsgWaitForMultipleObjects(0, NULL, FALSE, milliseconds, QS_ALLINPUT) != WAIT_TIMEOUT) {
+					return;
+				}
+			}
+			else {
+				Sleep(milliseconds);
+			}
+		}
+
+		while (m_clockProc() < m_nextFrameTime) {
+			if (p_wakeOnMessage && HIWORD(GetQueueStatus(QS_ALLINPUT)) != 0) {
+				return;
+			}
+		}
+	}
+
+	// Returns the frame time in microseconds that p_percent percent of the frames
+	// did not exceed, with the precision of a histogram bucket
+	MxS64 GetPercentile(MxU32 p_percent)
+	{
+		MxU32 target = (m_numFrames * p_percent + 99) / 100;
+		MxU32 count = 0;
+
+		for (MxS32 i = 0; i < c_numBuckets && target != 0; i++) {
+			count += m_histogram[i];
+
+			if (count >= target) {
+				return (MxS64) (i + 1) * c_bucketMicroseconds;
+			}
+		}
+
+		return 0;
+	}
+
+	MxU32 GetNumFrames() { return m_numFrames; }
+
+	void ResetStatistics()
+	{
+		memset(m_histogram, 0, sizeof(m_histogram));
+		m_numFrames = 0;
+	}
+
+private:
+	MxClockProc m_clockProc;         // 0x00
+	MxS64 m_frameDelta;              // 0x08
+	MxS64 m_nextFrameTime;           // 0x10
+	MxS64 m_lastFrameTime;           // 0x18
+	MxU32 m_histogram[c_numBuckets]; // 0x20
+	MxU32 m_numFrames;               // 0x220
+};
+
+#endif // MXFRAMEPACER_H
@@ -3,6 +3,7 @@
 
 #include "mxatom.h"
 #include "mxcore.h"
+#include "mxobjectfactorytable.h"
 
 #define FOR_MXOBJECTFACTORY_OBJECTS(X)                                                                                 \
 	X(MxPresenter)                                                                                                     \
@@ -41,6 +42,9 @@ class MxObjectFactory : public MxCore {
 	virtual MxCore* Create(const char* p_name); // vtable+0x14
 	virtual void Destroy(MxCore* p_object);     // vtable+0x18
 
+	// Not part of the original game
+	static MxObjectFactoryTable& GetTable() { return g_table; }
+
 	// SYNTHETIC: LEGO1 0x100b1160
 	// MxObjectFactory::`scalar deleting destructor'
 
@@ -51,6 +55,8 @@ class MxObjectFactory : public MxCore {
 #define X(V) MxAtomId m_id##V;
 	FOR_MXOBJECTFACTORY_OBJECTS(X)
 #undef X
+
+	static MxObjectFactoryTable g_table;
 };
 
 #endif // MXOBJECTFACTORY_H
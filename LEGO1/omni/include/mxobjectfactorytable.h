@@ -0,0 +1,56 @@
+#ifndef MXOBJECTFACTORYTABLE_H
+#define MXOBJECTFACTORYTABLE_H
+
+#include "decomp.h"
+#include "mxtypes.h"
+
+class MxCore;
+
+typedef MxCore* (*MxObjectCreator)();
+
+// Maps class names to the functions that create them, so an object factory
+// finds a class with one hash lookup instead of comparing the name's atom
+// against every class it knows. Names are matched exactly, like the e_exact
+// atoms they replace, and have to outlive the table. The table counts how often
+// each class is created, for profiling world start-up.
+// Not part of the original game.
+// SIZE 0x1004
+class MxObjectFactoryTable {
+public:
+	enum {
+		c_numSlots = 256
+	};
+
+	MxObjectFactoryTable();
+
+	// Registering a name again replaces its creator
+	void Register(const char* p_name, MxObjectCreator p_creator);
+
+	// Returns NULL if the name is not registered
+	MxCore* Create(const char* p_name);
+
+	MxS32 GetNumSlots() { return c_numSlots; }
+	const char* GetName(MxS32 p_slot) { return m_entries[p_slot].m_name; }
+	MxU32 GetCount(MxS32 p_slot) { return m_entries[p_slot].m_count; }
+	MxU32 GetNumEntries() { return m_numEntries; }
+
+	void ResetCounts();
+
+private:
+	// SIZE 0x10
+	struct Entry {
+		const char* m_name;        // 0x00
+		MxU32 m_hash;              // 0x04
+		MxObjectCreator m_creator; // 0x08
+		MxU32 m_count;             // 0x0c
+	};
+
+	static MxU32 Hash(const char* p_name);
+
+	Entry* Find(const char* p_name, MxU32 p_hash);
+
+	Entry m_entries[c_numSlots]; // 0x0000
+	MxU32 m_numEntries;          // 0x1000
+};
+
+#endif // MXOBJECTFACTORYTABLE_H
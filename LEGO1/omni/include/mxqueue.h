@@ -6,10 +6,7 @@
 template <class T>
 class MxQueue : public MxList<T> {
 public:
-	void Enqueue(T& p_obj)
-	{
-		// TODO
-	}
+	void Enqueue(T& p_obj) { this->Append(p_obj); }
 
 	MxBool Dequeue(T& p_obj)
 	{
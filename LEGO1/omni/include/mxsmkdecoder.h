@@ -0,0 +1,84 @@
+#ifndef MXSMKDECODER_H
+#define MXSMKDECODER_H
+
+#include "decomp.h"
+#include "mxcriticalsection.h"
+#include "mxrectlist.h"
+#include "mxsemaphore.h"
+#include "mxthread.h"
+#include "mxtypes.h"
+
+class MxBitmap;
+class MxSmkDecoder;
+class MxStreamChunk;
+struct MxSmk;
+
+// Not part of the original game.
+// SIZE 0x20
+class MxSmkDecoderThread : public MxThread {
+public:
+	MxSmkDecoderThread() : MxThread() { m_decoder = NULL; }
+
+	MxResult Run() override;
+	MxResult StartWithDecoder(MxSmkDecoder* p_decoder);
+
+private:
+	MxSmkDecoder* m_decoder; // 0x1c
+};
+
+// Decodes the frames of a Smacker stream on a worker thread, ahead of the time
+// they are presented. Frames are decoded strictly in the order they are submitted,
+// each into a bitmap of a small ring together with the rects that changed.
+// The presenter then swaps the decoded bitmap with its own frame bitmap.
+// Not part of the original game.
+// SIZE 0xc4
+class MxSmkDecoder {
+public:
+	enum {
+		c_numFrames = 2
+	};
+
+	// SIZE 0x30
+	struct Frame {
+		MxStreamChunk* m_chunk;  // 0x00
+		MxLong m_time;           // 0x04
+		MxU8* m_data;            // 0x08
+		MxU32 m_dataSize;        // 0x0c
+		MxBool m_paletteChanged; // 0x10
+		MxBitmap* m_bitmap;      // 0x14
+		MxRectList m_rects;      // 0x18
+	};
+
+	MxSmkDecoder();
+	~MxSmkDecoder();
+
+	MxResult Create(MxSmk* p_mxSmk, MxBitmap* p_frameBitmap);
+	void Destroy();
+
+	MxResult Submit(MxStreamChunk* p_chunk, MxBool p_paletteChanged);
+	MxS32 Acquire(MxStreamChunk* p_chunk);
+	void Release(MxS32 p_index);
+	void WaitIdle();
+	void DecodeFrames();
+
+	Frame& GetFrame(MxS32 p_index) { return m_frames[p_index]; }
+	MxBool IsEmpty() { return m_count == 0; }
+	MxBool IsFull() { return m_count == c_numFrames; }
+
+private:
+	void DecodeNextFrame();
+
+	MxSmk* m_mxSmk;              // 0x00
+	MxBitmap* m_decodeBitmap;    // 0x04
+	Frame m_frames[c_numFrames]; // 0x08
+	MxS32 m_head;                // 0x68
+	MxS32 m_count;               // 0x6c
+	MxS32 m_numDecoded;          // 0x70
+	MxBool m_running;            // 0x74
+	MxCriticalSection m_lock;    // 0x78
+	MxSemaphore m_workSemaphore; // 0x94
+	MxSemaphore m_doneSemaphore; // 0x9c
+	MxSmkDecoderThread m_thread; // 0xa4
+};
+
+#endif // MXSMKDECODER_H
@@ -5,6 +5,8 @@
 #include "mxsmk.h"
 #include "mxvideopresenter.h"
 
+class MxSmkDecoder;
+
 // VTABLE: LEGO1 0x100dc348
 // SIZE 0x720
 class MxSmkPresenter : public MxVideoPresenter {
@@ -40,12 +42,19 @@ class MxSmkPresenter : public MxVideoPresenter {
 	void RealizePalette() override;                   // vtable+0x70
 	virtual void VTable0x88();                        // vtable+0x88
 
+	static void SetDecodeInBackground(MxBool p_decodeInBackground);
+	static MxBool GetDecodeInBackground() { return g_decodeInBackground; }
+
 	// SYNTHETIC: LEGO1 0x100b3850
 	// MxSmkPresenter::`scalar deleting destructor'
 
 private:
 	void Init();
 	void Destroy(MxBool p_fromDestructor);
+	void SubmitFrame(MxSmkDecoder* p_decoder, MxStreamChunk* p_chunk);
+	void LoadDecodedFrame(MxSmkDecoder* p_decoder, MxStreamChunk* p_chunk);
+
+	static MxBool g_decodeInBackground;
 
 protected:
 	MxSmk m_mxSmk;        // 0x64
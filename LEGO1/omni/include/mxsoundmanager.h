@@ -7,6 +7,9 @@
 
 #include <dsound.h>
 
+class MxAudioMixer;
+class MxAudioOutput;
+
 // VTABLE: LEGO1 0x100dc128
 // SIZE 0x3c
 class MxSoundManager : public MxAudioManager {
@@ -23,6 +26,15 @@ class MxSoundManager : public MxAudioManager {
 	LPDIRECTSOUND GetDirectSound() { return m_directSound; }
 
 	MxS32 GetAttenuation(MxU32 p_volume);
+	MxResult CreateSoundBuffer(LPCDSBUFFERDESC p_desc, LPDIRECTSOUNDBUFFER* p_buffer);
+	MxResult DuplicateSoundBuffer(LPDIRECTSOUNDBUFFER p_source, LPDIRECTSOUNDBUFFER* p_buffer);
+
+	// The software mixer is not part of the original game
+	static void SetMixerOutput(MxAudioOutput* p_output);
+	static MxResult SetMixerOutput(const char* p_name);
+	static MxAudioOutput* GetMixerOutput() { return g_mixerOutput; }
+	static MxAudioMixer* GetMixer() { return g_mixer; }
+	static MxBool IsSound3D();
 
 	MxPresenter* FUN_100aebd0(const MxAtomId& p_atomId, MxU32 p_objectId);
 
@@ -33,6 +45,10 @@ class MxSoundManager : public MxAudioManager {
 	LPDIRECTSOUND m_directSound;    // 0x30
 	LPDIRECTSOUNDBUFFER m_dsBuffer; // 0x34
 	undefined m_unk0x38[4];
+
+private:
+	static MxAudioOutput* g_mixerOutput;
+	static MxAudioMixer* g_mixer;
 };
 
 // SYNTHETIC: LEGO1 0x100ae7b0
@@ -23,6 +23,7 @@ class MxString : public MxCore {
 	MxString operator+(const MxString& p_str) const;
 	MxString operator+(const char* p_str) const;
 	MxString& operator+=(const char* p_str);
+	MxString& operator+=(const MxString& p_str);
 
 	static void CharSwap(char* p_a, char* p_b);
 
@@ -38,13 +39,47 @@ class MxString : public MxCore {
 	// FUNCTION: BETA10 0x1012a810
 	MxS8 Compare(const MxString& p_str) const { return strcmp(m_data, p_str.m_data); }
 
+	// Not part of the original game
+	static MxU32 GetNumAllocations() { return g_numAllocations; }
+
 	// SYNTHETIC: LEGO1 0x100ae280
 	// SYNTHETIC: BETA10 0x1012c9d0
 	// MxString::`scalar deleting destructor'
 
 private:
-	char* m_data;   // 0x08
-	MxU16 m_length; // 0x0c
+	enum {
+		c_maxLength = 0xffff,
+		c_poolCapacity = 29
+	};
+
+	MxString(const char* p_str1, MxU32 p_length1, const char* p_str2, MxU32 p_length2);
+
+	// Not part of the original game.
+	// A single character fits into the padding at the end of the class, which
+	// has to stay 0x10 bytes. Strings up to c_poolCapacity characters, which
+	// covers typical object and variable names, take a block from a pool.
+	// Longer strings are allocated. The capacity is stored in front of the data,
+	// so assignments and appends that fit reuse the block.
+	void Init()
+	{
+		m_data = m_inline;
+		m_inline[0] = '\0';
+		m_length = 0;
+	}
+
+	MxBool IsInline() const { return m_data == m_inline; }
+	MxU16 GetCapacity() const { return IsInline() ? (MxU16) (sizeof(m_inline) - 1) : ((MxU16*) m_data)[-1]; }
+
+	void Assign(const char* p_str, MxU32 p_length);
+	void Append(const char* p_str, MxU32 p_length);
+	static char* Allocate(MxU16 p_capacity);
+	void FreeData();
+
+	char* m_data;     // 0x08
+	MxU16 m_length;   // 0x0c
+	char m_inline[2]; // 0x0e
+
+	static MxU32 g_numAllocations;
 };
 
 #endif // MXSTRING_H
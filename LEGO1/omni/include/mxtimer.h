@@ -1,6 +1,7 @@
 #ifndef MXTIMER_H
 #define MXTIMER_H
 
+#include "mxclock.h"
 #include "mxcore.h"
 
 // VTABLE: LEGO1 0x100dc0e0
@@ -30,6 +31,9 @@ class MxTimer : public MxCore {
 		}
 	}
 
+	// Not part of the original game
+	static void SetClockProc(MxClockProc p_clockProc) { g_clockProc = p_clockProc; }
+
 	// SYNTHETIC: LEGO1 0x100ae0d0
 	// SYNTHETIC: BETA10 0x1012bf80
 	// MxTimer::`scalar deleting destructor'
@@ -40,6 +44,11 @@ class MxTimer : public MxCore {
 
 	static MxLong g_lastTimeCalculated;
 	static MxLong g_lastTimeTimerStarted;
+
+	// Not part of the original game
+	static MxLong GetClockTime() { return (MxLong) (g_clockProc() / 1000); }
+
+	static MxClockProc g_clockProc;
 };
 
 // SYNTHETIC: BETA10 0x1012bfc0
@@ -0,0 +1,94 @@
+#ifndef MXTYPEIDTABLE_H
+#define MXTYPEIDTABLE_H
+
+#include "decomp.h"
+#include "mxcore.h"
+#include "mxcriticalsection.h"
+#include "mxtypes.h"
+
+// Answers IsA queries with a bit test instead of walking the class chain with
+// a string comparison per level. A type is identified by an id handed out for
+// its name, a class by the address its ClassName returns. The first query of a
+// class for a type is answered by the virtual IsA, the result is then kept in a
+// bitset per class. MxCore::IsA and its overrides stay the reference.
+// Classes whose ClassName depends on the instance, like LegoVehicleBuildState,
+// must not be queried through this table.
+// Not part of the original game.
+// SIZE 0x2928
+class MxTypeIdTable {
+public:
+	enum {
+		c_maxTypes = 64,
+		c_numWords = c_maxTypes / 32,
+		c_numClassSlots = 512
+	};
+
+	MxTypeIdTable();
+
+	static MxTypeIdTable* GetInstance();
+
+	// p_name has to outlive the table. Returns -1 if the table is full.
+	MxS32 GetTypeId(const char* p_name);
+
+	MxBool IsA(const MxCore* p_object, MxS32 p_typeId);
+
+	MxU32 GetNumHits() { return m_numHits; }
+	MxU32 GetNumMisses() { return m_numMisses; }
+
+	void ResetStatistics()
+	{
+		m_numHits = 0;
+		m_numMisses = 0;
+	}
+
+private:
+	// SIZE 0x14
+	struct ClassEntry {
+		const char* volatile m_className; // 0x00
+		MxU32 m_known[c_numWords];        // 0x04
+		MxU32 m_results[c_numWords];      // 0x0c
+	};
+
+	ClassEntry* FindClass(const char* p_className);
+
+	const char* m_typeNames[c_maxTypes];   // 0x0000
+	MxS32 m_numTypes;                      // 0x0100
+	ClassEntry m_classes[c_numClassSlots]; // 0x0104
+	MxU32 m_numHits;                       // 0x2904
+	MxU32 m_numMisses;                     // 0x2908
+	MxCriticalSection m_lock;              // 0x290c
+};
+
+// A type id that is looked up on first use, meant for globals
+// SIZE 0x08
+class MxTypeId {
+public:
+	MxTypeId(const char* p_name)
+	{
+		m_name = p_name;
+		m_id = -1;
+	}
+
+	const char* GetName() const { return m_name; }
+
+	MxS32 GetId()
+	{
+		if (m_id < 0) {
+			m_id = MxTypeIdTable::GetInstance()->GetTypeId(m_name);
+		}
+
+		return m_id;
+	}
+
+private:
+	const char* m_name; // 0x00
+	MxS32 m_id;         // 0x04
+};
+
+inline MxBool MxIsA(const MxCore* p_object, MxTypeId& p_type)
+{
+	MxS32 id = p_type.GetId();
+	return id >= 0 ? MxTypeIdTable::GetInstance()->IsA(p_object, id) : p_object->IsA(p_type.GetName());
+}
+
+#endif // MXTYPEIDTABLE_H
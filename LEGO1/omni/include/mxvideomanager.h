@@ -45,6 +45,11 @@ class MxVideoManager : public MxMediaManager {
 	MxDisplaySurface* GetDisplaySurface() { return this->m_displaySurface; }
 	MxRegion* GetRegion() { return this->m_region; }
 
+	// Not part of the original game.
+	// Signals that the screen rect or the list order of some presenter may have changed.
+	static void InvalidateLayout() { g_layoutVersion++; }
+	static MxU32 GetLayoutVersion() { return g_layoutVersion; }
+
 	// SYNTHETIC: LEGO1 0x100be280
 	// MxVideoManager::`scalar deleting destructor'
 
@@ -55,6 +60,9 @@ class MxVideoManager : public MxMediaManager {
 	MxDisplaySurface* m_displaySurface; // 0x58
 	MxRegion* m_region;                 // 0x5c
 	MxBool m_unk0x60;                   // 0x60
+
+private:
+	static MxU32 g_layoutVersion;
 };
 
 #endif // MXVIDEOMANAGER_H
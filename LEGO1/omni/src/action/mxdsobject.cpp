@@ -7,11 +7,13 @@
 #include "mxdsmediaaction.h"
 #include "mxdsmultiaction.h"
 #include "mxdsobjectaction.h"
+#include "mxdsobjectpool.h"
 #include "mxdsparallelaction.h"
 #include "mxdsselectaction.h"
 #include "mxdsserialaction.h"
 #include "mxdssound.h"
 #include "mxdsstill.h"
+#include "mxdsstringtable.h"
 #include "mxutilities.h"
 
 #include <stdlib.h>
@@ -37,8 +39,8 @@ MxDSObject::MxDSObject()
 // FUNCTION: BETA10 0x1014798e
 MxDSObject::~MxDSObject()
 {
-	delete[] m_objectName;
-	delete[] m_sourceName;
+	MxDSStringTable::GetInstance()->Release(m_objectName);
+	MxDSStringTable::GetInstance()->Release(m_sourceName);
 }
 
 // FUNCTION: LEGO1 0x100bf870
@@ -80,18 +82,10 @@ void MxDSObject::SetObjectName(const char* p_objectName)
 		return;
 	}
 
-	delete[] m_objectName;
-
-	if (p_objectName) {
-		m_objectName = new char[strlen(p_objectName) + 1];
-
-		if (m_objectName) {
-			strcpy(m_objectName, p_objectName);
-		}
-	}
-	else {
-		m_objectName = NULL;
-	}
+	// Names are shared with all other objects of the same name
+	const char* previous = m_objectName;
+	m_objectName = (char*) MxDSStringTable::GetInstance()->Acquire(p_objectName);
+	MxDSStringTable::GetInstance()->Release(previous);
 }
 
 // FUNCTION: LEGO1 0x100bf950
@@ -102,18 +96,20 @@ void MxDSObject::SetSourceName(const char* p_sourceName)
 		return;
 	}
 
-	delete[] m_sourceName;
+	// Names are shared with all other objects of the same name
+	const char* previous = m_sourceName;
+	m_sourceName = (char*) MxDSStringTable::GetInstance()->Acquire(p_sourceName);
+	MxDSStringTable::GetInstance()->Release(previous);
+}
 
-	if (p_sourceName) {
-		m_sourceName = new char[strlen(p_sourceName) + 1];
+void* MxDSObject::operator new(size_t p_size)
+{
+	return MxDSObjectPool::GetInstance()->Allocate(p_size);
+}
 
-		if (m_sourceName) {
-			strcpy(m_sourceName, p_sourceName);
-		}
-	}
-	else {
-		m_sourceName = NULL;
-	}
+void MxDSObject::operator delete(void* p_memory)
+{
+	MxDSObjectPool::GetInstance()->Free(p_memory);
 }
 
 // FUNCTION: LEGO1 0x100bf9c0
@@ -0,0 +1,109 @@
+#include "mxdsobjectpool.h"
+
+#include "mxautolock.h"
+
+#include <string.h>
+
+DECOMP_SIZE_ASSERT(MxDSObjectPool, 0x6c)
+
+MxDSObjectPool::MxDSObjectPool()
+{
+	memset(m_freeLists, 0, sizeof(m_freeLists));
+	m_block = NULL;
+	m_blockUsed = 0;
+	m_enabled = TRUE;
+	m_numLive = 0;
+	m_numReused = 0;
+	m_numFromHeap = 0;
+	m_bytesLive = 0;
+	m_bytesReserved = 0;
+}
+
+// The pool is never destroyed, since objects may still be deleted while
+// static objects are torn down
+MxDSObjectPool* MxDSObjectPool::GetInstance()
+{
+	static MxDSObjectPool* g_instance = new MxDSObjectPool;
+	return g_instance;
+}
+
+void* MxDSObjectPool::Allocate(size_t p_size)
+{
+	MxU32 size = p_size + sizeof(Header);
+	MxS32 sizeClass = (size + c_granularity - 1) / c_granularity - 1;
+	Header* header;
+
+	if (!m_enabled || sizeClass >= c_numSizeClasses) {
+		header = (Header*) new MxU8[size];
+
+		if (header == NULL) {
+			return NULL;
+		}
+
+		header->m_sizeClass = -1;
+		header->m_size = size;
+
+		AUTOLOCK(m_lock);
+		m_numFromHeap++;
+		m_numLive++;
+		m_bytesLive += size;
+		return header + 1;
+	}
+
+	MxU32 slotSize = (sizeClass + 1) * c_granularity;
+
+	AUTOLOCK(m_lock);
+
+	if (m_freeLists[sizeClass] != NULL) {
+		header = (Header*) m_freeLists[sizeClass];
+		m_freeLists[sizeClass] = m_freeLists[sizeClass]->m_next;
+		m_numReused++;
+	}
+	else {
+		// The rest of a full block is left unused, it is smaller than any object
+		if (m_block == NULL || m_blockUsed + slotSize > c_blockSize) {
+			m_block = new MxU8[c_blockSize];
+
+			if (m_block == NULL) {
+				return NULL;
+			}
+
+			m_blockUsed = 0;
+			m_bytesReserved += c_blockSize;
+		}
+
+		header = (Header*) (m_block + m_blockUsed);
+		m_blockUsed += slotSize;
+	}
+
+	header->m_sizeClass = sizeClass;
+	header->m_size = slotSize;
+
+	m_numLive++;
+	m_bytesLive += slotSize;
+	return header + 1;
+}
+
+void MxDSObjectPool::Free(void* p_memory)
+{
+	if (p_memory == NULL) {
+		return;
+	}
+
+	Header* header = (Header*) p_memory - 1;
+
+	AUTOLOCK(m_lock);
+
+	m_numLive--;
+	m_bytesLive -= header->m_size;
+
+	if (header->m_sizeClass < 0) {
+		delete[] (MxU8*) header;
+	}
+	else {
+		FreeNode* node = (FreeNode*) header;
+		MxS32 sizeClass = header->m_sizeClass;
+		node->m_next = m_freeLists[sizeClass];
+		m_freeLists[sizeClass] = node;
+	}
+}
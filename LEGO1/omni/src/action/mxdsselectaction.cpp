@@ -1,5 +1,7 @@
 #include "mxdsselectaction.h"
 
+#include "mxdirectx/mxstopwatch.h"
+#include "mxdschunk.h"
 #include "mxmisc.h"
 #include "mxtimer.h"
 #include "mxvariabletable.h"
@@ -9,6 +11,12 @@ DECOMP_SIZE_ASSERT(MxStringList, 0x18)
 DECOMP_SIZE_ASSERT(MxStringListCursor, 0x10)
 DECOMP_SIZE_ASSERT(MxListEntry<MxString>, 0x18)
 
+// Not part of the original game.
+MxU32 MxDSSelectAction::g_numParsed = 0;
+MxU32 MxDSSelectAction::g_numSkipped = 0;
+MxU32 MxDSSelectAction::g_bytesSkipped = 0;
+double MxDSSelectAction::g_parseSeconds = 0.0;
+
 // FUNCTION: LEGO1 0x100cb2b0
 // FUNCTION: BETA10 0x1015a515
 MxDSSelectAction::MxDSSelectAction()
@@ -87,6 +95,8 @@ MxU32 MxDSSelectAction::GetSizeOnDisk()
 void MxDSSelectAction::Deserialize(MxU8*& p_source, MxS16 p_unk0x24)
 {
 	MxString string;
+	MxStopWatch stopWatch;
+	stopWatch.Start();
 	MxDSAction::Deserialize(p_source, p_unk0x24);
 
 	MxU32 extraFlag = *(MxU32*) (p_source + 4) & 1;
@@ -126,21 +136,30 @@ void MxDSSelectAction::Deserialize(MxU8*& p_source, MxS16 p_unk0x24)
 		}
 
 		for (i = 0; i < count; i++) {
+			if (index != i) {
+				// Branches that are not selected are skipped by their chunk size
+				// instead of being deserialized and deleted right away
+				MxU8* end = MxDSChunk::End(p_source);
+				g_numSkipped++;
+				g_bytesSkipped += end - p_source;
+				p_source = end;
+				continue;
+			}
+
 			MxU32 extraFlag = *(MxU32*) (p_source + 4) & 1;
 			p_source += 8;
 
 			MxDSAction* action = (MxDSAction*) DeserializeDSObjectDispatch(p_source, p_unk0x24);
-
-			if (index == i) {
-				this->m_actions->Append(action);
-			}
-			else {
-				delete action;
-			}
+			this->m_actions->Append(action);
 
 			p_source += extraFlag;
 		}
 	}
 
 	p_source += extraFlag;
+
+	// Includes the time spent in nested select actions
+	stopWatch.Stop();
+	g_numParsed++;
+	g_parseSeconds += stopWatch.ElapsedSeconds();
 }
@@ -0,0 +1,108 @@
+#include "mxdsstringtable.h"
+
+#include "mxautolock.h"
+
+#include <string.h>
+
+DECOMP_SIZE_ASSERT(MxDSStringTable, 0x42c)
+
+MxDSStringTable::MxDSStringTable()
+{
+	memset(m_buckets, 0, sizeof(m_buckets));
+	m_numStrings = 0;
+	m_numReferences = 0;
+	m_bytesStored = 0;
+	m_bytesShared = 0;
+}
+
+// The table is never destroyed, since objects may still release their names
+// while static objects are torn down
+MxDSStringTable* MxDSStringTable::GetInstance()
+{
+	static MxDSStringTable* g_instance = new MxDSStringTable;
+	return g_instance;
+}
+
+const char* MxDSStringTable::Acquire(const char* p_string)
+{
+	if (p_string == NULL) {
+		return NULL;
+	}
+
+	MxU32 length;
+	MxU32 hash = Hash(p_string, length);
+	Entry** bucket = &m_buckets[hash & (c_numBuckets - 1)];
+
+	AUTOLOCK(m_lock);
+
+	for (Entry* entry = *bucket; entry != NULL; entry = entry->m_next) {
+		if (entry->m_hash == hash && entry->m_length == length && !memcmp(entry->m_string, p_string, length)) {
+			entry->m_refCount++;
+			m_numReferences++;
+			m_bytesShared += length + 1;
+			return entry->m_string;
+		}
+	}
+
+	MxU32 size = offsetof(Entry, m_string) + length + 1;
+	Entry* entry = (Entry*) new MxU8[size];
+
+	if (entry == NULL) {
+		return NULL;
+	}
+
+	entry->m_hash = hash;
+	entry->m_refCount = 1;
+	entry->m_length = length;
+	memcpy(entry->m_string, p_string, length + 1);
+
+	entry->m_next = *bucket;
+	*bucket = entry;
+
+	m_numStrings++;
+	m_numReferences++;
+	m_bytesStored += size;
+	return entry->m_string;
+}
+
+void MxDSStringTable::Release(const char* p_string)
+{
+	if (p_string == NULL) {
+		return;
+	}
+
+	Entry* entry = GetEntry(p_string);
+
+	AUTOLOCK(m_lock);
+
+	m_numReferences--;
+
+	if (--entry->m_refCount != 0) {
+		return;
+	}
+
+	for (Entry** it = &m_buckets[entry->m_hash & (c_numBuckets - 1)]; *it != NULL; it = &(*it)->m_next) {
+		if (*it == entry) {
+			*it = entry->m_next;
+			break;
+		}
+	}
+
+	m_numStrings--;
+	m_bytesStored -= offsetof(Entry, m_string) + entry->m_length + 1;
+	delete[] (MxU8*) entry;
+}
+
+// FNV-1a
+MxU32 MxDSStringTable::Hash(const char* p_string, MxU32& p_length)
+{
+	MxU32 hash = 2166136261u;
+	const char* c;
+
+	for (c = p_string; *c != '\0'; c++) {
+		hash = (hash ^ (MxU8) *c) * 16777619u;
+	}
+
+	p_length = c - p_string;
+	return hash;
+}
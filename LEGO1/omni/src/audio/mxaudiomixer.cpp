@@ -0,0 +1,723 @@
+#include "mxaudiomixer.h"
+
+#include "mxaudiooutput.h"
+#include "mxautolock.h"
+#include "mxdirectx/mxstopwatch.h"
+#include "mxticklethread.h"
+#include "mxutilities.h"
+
+#include <math.h>
+
+DECOMP_SIZE_ASSERT(MxMixerVoice, 0x48)
+DECOMP_SIZE_ASSERT(MxAudioMixer, 0x50)
+
+// Converts a DirectSound attenuation, in hundredths of a decibel, to a linear gain
+inline MxS32 AttenuationToGain(LONG p_attenuation)
+{
+	if (p_attenuation <= DSBVOLUME_MIN) {
+		return 0;
+	}
+
+	return (MxS32) (MxAudioMixer::c_unityGain * pow(10.0, p_attenuation / 2000.0));
+}
+
+// The sample data of a voice is shared with its duplicates, like the memory of
+// a duplicated DirectSound buffer. The reference count is stored in front of it.
+inline MxU8* AllocVoiceData(MxU32 p_dataSize)
+{
+	MxU8* block = new MxU8[sizeof(LONG) + p_dataSize];
+	*(LONG*) block = 1;
+	return block + sizeof(LONG);
+}
+
+inline void AddRefVoiceData(MxU8* p_data)
+{
+	InterlockedIncrement((LONG*) (p_data - sizeof(LONG)));
+}
+
+inline void ReleaseVoiceData(MxU8* p_data)
+{
+	if (p_data != NULL && InterlockedDecrement((LONG*) (p_data - sizeof(LONG))) == 0) {
+		delete[] (p_data - sizeof(LONG));
+	}
+}
+
+inline MxS32 RampGain(MxS32 p_gain, MxS32 p_target)
+{
+	const MxS32 step = MxAudioMixer::c_unityGain / MxAudioMixer::c_rampFrames;
+
+	if (p_gain < p_target) {
+		return Min(p_gain + step, p_target);
+	}
+
+	return Max(p_gain - step, p_target);
+}
+
+MxMixerVoice::MxMixerVoice(MxAudioMixer* p_mixer)
+{
+	m_refCount = 1;
+	m_mixer = p_mixer;
+	m_data = NULL;
+	m_dataSize = 0;
+	m_flags = 0;
+	m_sampleRate = 0;
+	m_frequency = 0;
+	m_channels = 0;
+	m_bitsPerSample = 0;
+	m_blockAlign = 0;
+	m_playing = FALSE;
+	m_looping = FALSE;
+	m_volume = DSBVOLUME_MAX;
+	m_pan = DSBPAN_CENTER;
+	m_position = 0;
+	m_fraction = 0;
+	m_gainLeft = m_gainRight = 0;
+	m_targetLeft = m_targetRight = 0;
+}
+
+MxMixerVoice::~MxMixerVoice()
+{
+	ReleaseVoiceData(m_data);
+}
+
+MxResult MxMixerVoice::Create(LPCDSBUFFERDESC p_desc)
+{
+	LPWAVEFORMATEX format = p_desc->lpwfxFormat;
+
+	// The mixer's output replaces the primary buffer, and only plain PCM can be mixed
+	if (p_desc->dwFlags & DSBCAPS_PRIMARYBUFFER || format == NULL || format->wFormatTag != WAVE_FORMAT_PCM ||
+		(format->nChannels != 1 && format->nChannels != 2) ||
+		(format->wBitsPerSample != 8 && format->wBitsPerSample != 16)) {
+		return FAILURE;
+	}
+
+	m_flags = p_desc->dwFlags;
+	m_sampleRate = m_frequency = format->nSamplesPerSec;
+	m_channels = format->nChannels;
+	m_bitsPerSample = format->wBitsPerSample;
+	m_blockAlign = m_channels * m_bitsPerSample / 8;
+	m_dataSize = p_desc->dwBufferBytes - p_desc->dwBufferBytes % m_blockAlign;
+
+	if (m_dataSize == 0) {
+		return FAILURE;
+	}
+
+	m_data = AllocVoiceData(m_dataSize);
+	memset(m_data, m_bitsPerSample == 8 ? 0x80 : 0, m_dataSize);
+
+	UpdateGains();
+	m_gainLeft = m_targetLeft;
+	m_gainRight = m_targetRight;
+	return SUCCESS;
+}
+
+// Shares the data of p_source, with its format, volume and pan. It plays from the start.
+void MxMixerVoice::Duplicate(MxMixerVoice* p_source)
+{
+	m_flags = p_source->m_flags;
+	m_sampleRate = p_source->m_sampleRate;
+	m_frequency = p_source->m_frequency;
+	m_channels = p_source->m_channels;
+	m_bitsPerSample = p_source->m_bitsPerSample;
+	m_blockAlign = p_source->m_blockAlign;
+	m_dataSize = p_source->m_dataSize;
+	m_volume = p_source->m_volume;
+	m_pan = p_source->m_pan;
+
+	AddRefVoiceData(p_source->m_data);
+	m_data = p_source->m_data;
+
+	UpdateGains();
+	m_gainLeft = m_targetLeft;
+	m_gainRight = m_targetRight;
+}
+
+void MxMixerVoice::Enter()
+{
+	MxAudioMixer::GetLock().Enter();
+}
+
+void MxMixerVoice::Leave()
+{
+	MxAudioMixer::GetLock().Leave();
+}
+
+// Pan attenuates the opposite side only, as DirectSound does
+void MxMixerVoice::UpdateGains()
+{
+	MxS32 gain = AttenuationToGain(m_volume);
+
+	m_targetLeft = m_pan > DSBPAN_CENTER ? (gain * AttenuationToGain(-m_pan)) >> MxAudioMixer::c_gainShift : gain;
+	m_targetRight = m_pan < DSBPAN_CENTER ? (gain * AttenuationToGain(m_pan)) >> MxAudioMixer::c_gainShift : gain;
+}
+
+// Returns FALSE if the voice stopped at the end of its buffer
+MxBool MxMixerVoice::Advance(MxU32 p_step, MxU32 p_numFrames)
+{
+	m_fraction += p_step;
+	m_position += m_fraction >> 16;
+	m_fraction &= 0xffff;
+
+	if (m_position >= p_numFrames) {
+		if (!m_looping) {
+			m_position = 0;
+			m_fraction = 0;
+			m_playing = FALSE;
+			return FALSE;
+		}
+
+		m_position %= p_numFrames;
+	}
+
+	return TRUE;
+}
+
+void MxMixerVoice::Mix(MxS32* p_accumulator, MxU32 p_frames, MxU16 p_channels, MxU32 p_sampleRate)
+{
+	MxU32 numFrames = m_dataSize / m_blockAlign;
+	MxU32 step = (MxU32) (((MxU64) m_frequency << 16) / p_sampleRate);
+	MxU32 lastChannel = m_channels - 1;
+
+	for (MxU32 i = 0; i < p_frames; i++) {
+		MxU32 next = m_position + 1 < numFrames ? m_position + 1 : (m_looping ? 0 : m_position);
+		MxS32 fraction = m_fraction >> 1;
+
+		MxS32 left = ReadSample(m_position, 0);
+		MxS32 right = ReadSample(m_position, lastChannel);
+		left += ((ReadSample(next, 0) - left) * fraction) >> 15;
+		right += ((ReadSample(next, lastChannel) - right) * fraction) >> 15;
+
+		if (m_gainLeft != m_targetLeft) {
+			m_gainLeft = RampGain(m_gainLeft, m_targetLeft);
+		}
+
+		if (m_gainRight != m_targetRight) {
+			m_gainRight = RampGain(m_gainRight, m_targetRight);
+		}
+
+		left = (left * m_gainLeft) >> MxAudioMixer::c_gainShift;
+		right = (right * m_gainRight) >> MxAudioMixer::c_gainShift;
+
+		if (p_channels == 2) {
+			p_accumulator[0] += left;
+			p_accumulator[1] += right;
+			p_accumulator += 2;
+		}
+		else {
+			*p_accumulator++ += (left + right) >> 1;
+		}
+
+		if (!Advance(step, numFrames)) {
+			break;
+		}
+	}
+}
+
+// Advances a voice that is not mixed, so its position matches the time it played
+void MxMixerVoice::Skip(MxU32 p_frames, MxU32 p_sampleRate)
+{
+	MxU32 numFrames = m_dataSize / m_blockAlign;
+	MxU64 step = ((MxU64) m_frequency << 16) / p_sampleRate;
+	MxU64 advance = step * p_frames + m_fraction;
+	MxU64 position = m_position + (advance >> 16);
+
+	m_fraction = (MxU32) (advance & 0xffff);
+
+	// Fade in once the voice is mixed again
+	m_gainLeft = m_gainRight = 0;
+
+	if (position < numFrames) {
+		m_position = (MxU32) position;
+	}
+	else if (m_looping) {
+		m_position = (MxU32) (position % numFrames);
+	}
+	else {
+		m_position = 0;
+		m_fraction = 0;
+		m_playing = FALSE;
+	}
+}
+
+STDMETHODIMP MxMixerVoice::QueryInterface(REFIID p_iid, LPVOID* p_object)
+{
+	if (IsEqualIID(p_iid, IID_IUnknown) || IsEqualIID(p_iid, IID_IDirectSoundBuffer)) {
+		*p_object = this;
+		AddRef();
+		return S_OK;
+	}
+
+	// There is no 3D interface, 3D sound is turned off while the mixer is used
+	*p_object = NULL;
+	return E_NOINTERFACE;
+}
+
+STDMETHODIMP_(ULONG) MxMixerVoice::AddRef()
+{
+	return InterlockedIncrement(&m_refCount);
+}
+
+STDMETHODIMP_(ULONG) MxMixerVoice::Release()
+{
+	LONG refCount = InterlockedDecrement(&m_refCount);
+
+	if (refCount == 0) {
+		Enter();
+
+		if (m_mixer) {
+			m_mixer->RemoveVoice(this);
+		}
+
+		Leave();
+		delete this;
+	}
+
+	return refCount;
+}
+
+STDMETHODIMP MxMixerVoice::GetCaps(LPDSBCAPS p_caps)
+{
+	p_caps->dwFlags = m_flags | DSBCAPS_LOCSOFTWARE;
+	p_caps->dwBufferBytes = m_dataSize;
+	p_caps->dwUnlockTransferRate = 0;
+	p_caps->dwPlayCpuOverhead = 0;
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::GetCurrentPosition(LPDWORD p_playCursor, LPDWORD p_writeCursor)
+{
+	Enter();
+
+	if (p_playCursor) {
+		*p_playCursor = m_position * m_blockAlign;
+	}
+
+	if (p_writeCursor) {
+		*p_writeCursor = m_position * m_blockAlign;
+	}
+
+	Leave();
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::GetFormat(LPWAVEFORMATEX p_format, DWORD p_size, LPDWORD p_sizeWritten)
+{
+	if (p_format != NULL) {
+		if (p_size < sizeof(WAVEFORMATEX)) {
+			return DSERR_INVALIDPARAM;
+		}
+
+		p_format->wFormatTag = WAVE_FORMAT_PCM;
+		p_format->nChannels = m_channels;
+		p_format->nSamplesPerSec = m_sampleRate;
+		p_format->nAvgBytesPerSec = m_sampleRate * m_blockAlign;
+		p_format->nBlockAlign = m_blockAlign;
+		p_format->wBitsPerSample = m_bitsPerSample;
+		p_format->cbSize = 0;
+	}
+
+	if (p_sizeWritten != NULL) {
+		*p_sizeWritten = sizeof(WAVEFORMATEX);
+	}
+
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::GetVolume(LPLONG p_volume)
+{
+	*p_volume = m_volume;
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::GetPan(LPLONG p_pan)
+{
+	*p_pan = m_pan;
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::GetFrequency(LPDWORD p_frequency)
+{
+	*p_frequency = m_frequency;
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::GetStatus(LPDWORD p_status)
+{
+	*p_status = 0;
+
+	if (m_playing) {
+		*p_status |= DSBSTATUS_PLAYING;
+
+		if (m_looping) {
+			*p_status |= DSBSTATUS_LOOPING;
+		}
+	}
+
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::Initialize(LPDIRECTSOUND p_directSound, LPCDSBUFFERDESC p_desc)
+{
+	return DSERR_ALREADYINITIALIZED;
+}
+
+STDMETHODIMP MxMixerVoice::Lock(
+	DWORD p_offset,
+	DWORD p_bytes,
+	LPVOID* p_audioPtr1,
+	LPDWORD p_audioBytes1,
+	LPVOID* p_audioPtr2,
+	LPDWORD p_audioBytes2,
+	DWORD p_flags
+)
+{
+	if (p_flags & DSBLOCK_FROMWRITECURSOR) {
+		p_offset = m_position * m_blockAlign;
+	}
+
+	if (p_flags & DSBLOCK_ENTIREBUFFER) {
+		p_bytes = m_dataSize;
+	}
+
+	if (p_offset >= m_dataSize || p_bytes > m_dataSize) {
+		return DSERR_INVALIDPARAM;
+	}
+
+	// The data is always accessible, a lock only splits the range where it wraps around
+	DWORD bytes1 = Min(p_bytes, (DWORD) (m_dataSize - p_offset));
+	*p_audioPtr1 = m_data + p_offset;
+	*p_audioBytes1 = bytes1;
+
+	if (p_audioPtr2 != NULL) {
+		*p_audioPtr2 = bytes1 < p_bytes ? m_data : NULL;
+	}
+
+	if (p_audioBytes2 != NULL) {
+		*p_audioBytes2 = p_bytes - bytes1;
+	}
+
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::Play(DWORD p_reserved1, DWORD p_reserved2, DWORD p_flags)
+{
+	Enter();
+	m_looping = (p_flags & DSBPLAY_LOOPING) != 0;
+	m_playing = TRUE;
+	Leave();
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::SetCurrentPosition(DWORD p_position)
+{
+	Enter();
+	m_position = Min((MxU32) (p_position / m_blockAlign), m_dataSize / m_blockAlign - 1);
+	m_fraction = 0;
+	Leave();
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::SetFormat(LPCWAVEFORMATEX p_format)
+{
+	return DSERR_INVALIDCALL;
+}
+
+STDMETHODIMP MxMixerVoice::SetVolume(LONG p_volume)
+{
+	Enter();
+	m_volume = Max(Min(p_volume, (LONG) DSBVOLUME_MAX), (LONG) DSBVOLUME_MIN);
+	UpdateGains();
+	Leave();
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::SetPan(LONG p_pan)
+{
+	Enter();
+	m_pan = Max(Min(p_pan, (LONG) DSBPAN_RIGHT), (LONG) DSBPAN_LEFT);
+	UpdateGains();
+	Leave();
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::SetFrequency(DWORD p_frequency)
+{
+	Enter();
+
+	if (p_frequency == DSBFREQUENCY_ORIGINAL) {
+		m_frequency = m_sampleRate;
+	}
+	else {
+		m_frequency = Max(Min(p_frequency, (DWORD) DSBFREQUENCY_MAX), (DWORD) DSBFREQUENCY_MIN);
+	}
+
+	Leave();
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::Stop()
+{
+	Enter();
+	m_playing = FALSE;
+	Leave();
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::Unlock(LPVOID p_audioPtr1, DWORD p_audioBytes1, LPVOID p_audioPtr2, DWORD p_audioBytes2)
+{
+	return DS_OK;
+}
+
+STDMETHODIMP MxMixerVoice::Restore()
+{
+	return DS_OK;
+}
+
+MxAudioMixer::MxAudioMixer()
+{
+	m_output = NULL;
+	m_thread = NULL;
+	m_accumulator = NULL;
+	m_samples = NULL;
+	m_sampleRate = 0;
+	m_channels = 0;
+	m_numMixedVoices = 0;
+	m_framesMixed = 0;
+	m_mixSeconds = 0.0;
+}
+
+MxAudioMixer::~MxAudioMixer()
+{
+	Destroy();
+}
+
+// Shared by the mixer and its voices. The lock is never destroyed, so a voice
+// used or released by its owner while the mixer is deleted never enters a freed
+// lock, and it sees either the mixer or NULL.
+MxCriticalSection& MxAudioMixer::GetLock()
+{
+	static MxCriticalSection* g_lock = new MxCriticalSection;
+	return *g_lock;
+}
+
+MxResult MxAudioMixer::Create(MxAudioOutput* p_output, MxU32 p_sampleRate, MxU16 p_channels, MxS32 p_frequencyMS)
+{
+	MxResult result = FAILURE;
+
+	// Created here, before any voice or the mixer thread can use it
+	GetLock();
+
+	m_sampleRate = p_sampleRate;
+	m_channels = p_channels;
+	m_accumulator = new MxS32[c_blockFrames * p_channels];
+	m_samples = new MxS16[c_blockFrames * p_channels];
+
+	if (!m_accumulator || !m_samples) {
+		goto done;
+	}
+
+	if (p_output->Open(p_sampleRate, p_channels) != SUCCESS) {
+		goto done;
+	}
+
+	m_output = p_output;
+	m_thread = new MxTickleThread(this, p_frequencyMS);
+
+	if (!m_thread || m_thread->Start(0, 0) != SUCCESS) {
+		goto done;
+	}
+
+	result = SUCCESS;
+
+done:
+	if (result != SUCCESS) {
+		Destroy();
+	}
+
+	return result;
+}
+
+void MxAudioMixer::Destroy()
+{
+	if (m_thread) {
+		m_thread->Terminate();
+		delete m_thread;
+		m_thread = NULL;
+	}
+
+	if (m_output) {
+		m_output->Close();
+		m_output = NULL;
+	}
+
+	GetLock().Enter();
+
+	// Voices may still be referenced by their owners, they keep working without a mixer
+	for (MxMixerVoiceVector::iterator it = m_voices.begin(); it != m_voices.end(); it++) {
+		(*it)->Detach();
+	}
+
+	m_voices.erase(m_voices.begin(), m_voices.end());
+	m_playing.erase(m_playing.begin(), m_playing.end());
+	GetLock().Leave();
+
+	delete[] m_accumulator;
+	m_accumulator = NULL;
+	delete[] m_samples;
+	m_samples = NULL;
+}
+
+MxResult MxAudioMixer::Tickle()
+{
+	if (m_output == NULL) {
+		return SUCCESS;
+	}
+
+	MxU32 frames = m_output->GetWritableFrames();
+
+	while (frames > 0) {
+		MxU32 blockFrames = Min(frames, (MxU32) c_blockFrames);
+		Mix(m_samples, blockFrames);
+		m_output->Write(m_samples, blockFrames);
+		frames -= blockFrames;
+	}
+
+	return SUCCESS;
+}
+
+MxResult MxAudioMixer::CreateVoice(LPCDSBUFFERDESC p_desc, LPDIRECTSOUNDBUFFER* p_buffer)
+{
+	MxMixerVoice* voice = new MxMixerVoice(this);
+
+	if (!voice || voice->Create(p_desc) != SUCCESS) {
+		if (voice) {
+			voice->Detach();
+			voice->Release();
+		}
+
+		return FAILURE;
+	}
+
+	AUTOLOCK(GetLock());
+	m_voices.push_back(voice);
+	*p_buffer = voice;
+	return SUCCESS;
+}
+
+MxResult MxAudioMixer::DuplicateVoice(LPDIRECTSOUNDBUFFER p_source, LPDIRECTSOUNDBUFFER* p_buffer)
+{
+	AUTOLOCK(GetLock());
+
+	for (MxMixerVoiceVector::iterator it = m_voices.begin(); it != m_voices.end(); it++) {
+		if ((LPDIRECTSOUNDBUFFER) *it == p_source) {
+			MxMixerVoice* voice = new MxMixerVoice(this);
+
+			if (!voice) {
+				return FAILURE;
+			}
+
+			voice->Duplicate(*it);
+			m_voices.push_back(voice);
+			*p_buffer = voice;
+			return SUCCESS;
+		}
+	}
+
+	// Not a voice of this mixer
+	return FAILURE;
+}
+
+void MxAudioMixer::RemoveVoice(MxMixerVoice* p_voice)
+{
+	AUTOLOCK(GetLock());
+
+	for (MxMixerVoiceVector::iterator it = m_voices.begin(); it != m_voices.end(); it++) {
+		if (*it == p_voice) {
+			m_voices.erase(it);
+			break;
+		}
+	}
+}
+
+// Mixes p_frames frames of the playing voices into p_samples, which holds
+// interleaved samples for the output's channels.
+void MxAudioMixer::Mix(MxS16* p_samples, MxU32 p_frames)
+{
+	AUTOLOCK(GetLock());
+
+	MxStopWatch stopWatch;
+	stopWatch.Start();
+
+	MxU32 framesMixed = 0;
+
+	while (framesMixed < p_frames) {
+		MxU32 blockFrames = Min(p_frames - framesMixed, (MxU32) c_blockFrames);
+		MixBlock(p_samples + framesMixed * m_channels, blockFrames);
+		framesMixed += blockFrames;
+	}
+
+	stopWatch.Stop();
+	m_mixSeconds += stopWatch.ElapsedSeconds();
+	m_framesMixed += p_frames;
+}
+
+// Collects the playing voices, the loudest first if there are too many to mix
+void MxAudioMixer::SelectVoices()
+{
+	m_playing.erase(m_playing.begin(), m_playing.end());
+
+	for (MxMixerVoiceVector::iterator it = m_voices.begin(); it != m_voices.end(); it++) {
+		if ((*it)->IsPlaying()) {
+			m_playing.push_back(*it);
+		}
+	}
+
+	if (m_playing.size() <= c_maxMixedVoices) {
+		return;
+	}
+
+	for (MxU32 i = 0; i < c_maxMixedVoices; i++) {
+		MxU32 loudest = i;
+
+		for (MxU32 j = i + 1; j < m_playing.size(); j++) {
+			if (m_playing[j]->GetLoudness() > m_playing[loudest]->GetLoudness()) {
+				loudest = j;
+			}
+		}
+
+		MxMixerVoice* voice = m_playing[i];
+		m_playing[i] = m_playing[loudest];
+		m_playing[loudest] = voice;
+	}
+}
+
+void MxAudioMixer::MixBlock(MxS16* p_samples, MxU32 p_frames)
+{
+	MxU32 numSamples = p_frames * m_channels;
+	memset(m_accumulator, 0, numSamples * sizeof(MxS32));
+
+	SelectVoices();
+	m_numMixedVoices = Min((MxU32) m_playing.size(), (MxU32) c_maxMixedVoices);
+
+	for (MxU32 i = 0; i < m_playing.size(); i++) {
+		if (i < m_numMixedVoices) {
+			m_playing[i]->Mix(m_accumulator, p_frames, m_channels, m_sampleRate);
+		}
+		else {
+			m_playing[i]->Skip(p_frames, m_sampleRate);
+		}
+	}
+
+	for (MxU32 j = 0; j < numSamples; j++) {
+		MxS32 sample = m_accumulator[j];
+
+		if (sample > 32767) {
+			sample = 32767;
+		}
+		else if (sample < -32768) {
+			sample = -32768;
+		}
+
+		p_samples[j] = (MxS16) sample;
+	}
+}
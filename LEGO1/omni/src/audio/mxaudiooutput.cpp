@@ -0,0 +1,287 @@
+#include "mxaudiooutput.h"
+
+#include "mxomni.h"
+#include "mxutilities.h"
+
+#include <mmsystem.h>
+
+DECOMP_SIZE_ASSERT(MxAudioOutput, 0x0c)
+DECOMP_SIZE_ASSERT(MxDirectSoundAudioOutput, 0x24)
+DECOMP_SIZE_ASSERT(MxNullAudioOutput, 0x18)
+DECOMP_SIZE_ASSERT(MxWaveFileAudioOutput, 0x20)
+
+MxDirectSoundAudioOutput::MxDirectSoundAudioOutput()
+{
+	m_directSound = NULL;
+	m_primaryBuffer = NULL;
+	m_buffer = NULL;
+	m_bufferSize = 0;
+	m_writeOffset = 0;
+	m_latency = 0;
+}
+
+MxDirectSoundAudioOutput::~MxDirectSoundAudioOutput()
+{
+	Close();
+}
+
+MxResult MxDirectSoundAudioOutput::Open(MxU32 p_sampleRate, MxU16 p_channels)
+{
+	MxResult result = FAILURE;
+	WAVEFORMATEX format;
+	DSBUFFERDESC desc;
+	LPVOID audioPtr1, audioPtr2;
+	DWORD audioBytes1, audioBytes2;
+
+	m_sampleRate = p_sampleRate;
+	m_channels = p_channels;
+
+	format.wFormatTag = WAVE_FORMAT_PCM;
+	format.nChannels = p_channels;
+	format.nSamplesPerSec = p_sampleRate;
+	format.wBitsPerSample = 16;
+	format.nBlockAlign = p_channels * 2;
+	format.nAvgBytesPerSec = format.nBlockAlign * p_sampleRate;
+	format.cbSize = 0;
+
+	if (DirectSoundCreate(NULL, &m_directSound, NULL) != DS_OK) {
+		goto done;
+	}
+
+	if (m_directSound->SetCooperativeLevel(MxOmni::GetInstance()->GetWindowHandle(), DSSCL_PRIORITY) != DS_OK) {
+		goto done;
+	}
+
+	memset(&desc, 0, sizeof(desc));
+	desc.dwSize = sizeof(desc);
+	desc.dwFlags = DSBCAPS_PRIMARYBUFFER;
+
+	// The primary format is only a hint, DirectSound converts if the device does not support it
+	if (m_directSound->CreateSoundBuffer(&desc, &m_primaryBuffer, NULL) == DS_OK) {
+		m_primaryBuffer->SetFormat(&format);
+	}
+
+	m_bufferSize = format.nAvgBytesPerSec * c_bufferMS / 1000;
+	m_bufferSize -= m_bufferSize % format.nBlockAlign;
+	m_latency = format.nAvgBytesPerSec * c_latencyMS / 1000;
+	m_latency -= m_latency % format.nBlockAlign;
+
+	memset(&desc, 0, sizeof(desc));
+	desc.dwSize = sizeof(desc);
+	desc.dwFlags = DSBCAPS_GETCURRENTPOSITION2;
+	desc.dwBufferBytes = m_bufferSize;
+	desc.lpwfxFormat = &format;
+
+	if (m_directSound->CreateSoundBuffer(&desc, &m_buffer, NULL) != DS_OK) {
+		goto done;
+	}
+
+	if (m_buffer->Lock(0, m_bufferSize, &audioPtr1, &audioBytes1, &audioPtr2, &audioBytes2, 0) != DS_OK) {
+		goto done;
+	}
+
+	memset(audioPtr1, 0, audioBytes1);
+	m_buffer->Unlock(audioPtr1, audioBytes1, audioPtr2, audioBytes2);
+
+	if (m_buffer->Play(0, 0, DSBPLAY_LOOPING) != DS_OK) {
+		goto done;
+	}
+
+	m_writeOffset = 0;
+	result = SUCCESS;
+
+done:
+	if (result != SUCCESS) {
+		Close();
+	}
+
+	return result;
+}
+
+void MxDirectSoundAudioOutput::Close()
+{
+	if (m_buffer) {
+		m_buffer->Stop();
+		m_buffer->Release();
+		m_buffer = NULL;
+	}
+
+	if (m_primaryBuffer) {
+		m_primaryBuffer->Release();
+		m_primaryBuffer = NULL;
+	}
+
+	if (m_directSound) {
+		m_directSound->Release();
+		m_directSound = NULL;
+	}
+}
+
+MxU32 MxDirectSoundAudioOutput::GetWritableFrames()
+{
+	DWORD status, playCursor, writeCursor;
+
+	if (m_buffer == NULL) {
+		return 0;
+	}
+
+	m_buffer->GetStatus(&status);
+
+	if (status & DSBSTATUS_BUFFERLOST) {
+		if (m_buffer->Restore() != DS_OK) {
+			return 0;
+		}
+
+		m_buffer->Play(0, 0, DSBPLAY_LOOPING);
+	}
+
+	if (m_buffer->GetCurrentPosition(&playCursor, &writeCursor) != DS_OK) {
+		return 0;
+	}
+
+	MxU32 queued = (m_writeOffset + m_bufferSize - playCursor) % m_bufferSize;
+
+	// More queued than was ever written ahead means the play cursor overtook us
+	if (queued > m_latency * 2) {
+		m_writeOffset = writeCursor;
+		queued = (m_writeOffset + m_bufferSize - playCursor) % m_bufferSize;
+	}
+
+	if (queued >= m_latency) {
+		return 0;
+	}
+
+	return (m_latency - queued) / (m_channels * 2);
+}
+
+MxResult MxDirectSoundAudioOutput::Write(const MxS16* p_samples, MxU32 p_frames)
+{
+	LPVOID audioPtr1, audioPtr2;
+	DWORD audioBytes1, audioBytes2;
+	MxU32 length = p_frames * m_channels * 2;
+
+	if (m_buffer == NULL ||
+		m_buffer->Lock(m_writeOffset, length, &audioPtr1, &audioBytes1, &audioPtr2, &audioBytes2, 0) != DS_OK) {
+		return FAILURE;
+	}
+
+	memcpy(audioPtr1, p_samples, audioBytes1);
+
+	if (audioPtr2 != NULL) {
+		memcpy(audioPtr2, (MxU8*) p_samples + audioBytes1, audioBytes2);
+	}
+
+	m_buffer->Unlock(audioPtr1, audioBytes1, audioPtr2, audioBytes2);
+	m_writeOffset = (m_writeOffset + length) % m_bufferSize;
+	return SUCCESS;
+}
+
+MxNullAudioOutput::MxNullAudioOutput()
+{
+	m_lastTime = 0;
+	m_remainder = 0;
+	m_framesWritten = 0;
+}
+
+MxResult MxNullAudioOutput::Open(MxU32 p_sampleRate, MxU16 p_channels)
+{
+	m_sampleRate = p_sampleRate;
+	m_channels = p_channels;
+	m_lastTime = timeGetTime();
+	m_remainder = 0;
+	m_framesWritten = 0;
+	return SUCCESS;
+}
+
+void MxNullAudioOutput::Close()
+{
+}
+
+MxU32 MxNullAudioOutput::GetWritableFrames()
+{
+	MxULong time = timeGetTime();
+
+	// Never catch up on more than a second, e.g. after the game was suspended
+	MxU32 elapsed = Min(time - m_lastTime, (MxULong) 1000);
+	MxU32 frames = elapsed * m_sampleRate + m_remainder;
+
+	m_lastTime = time;
+	m_remainder = frames % 1000;
+	return frames / 1000;
+}
+
+MxResult MxNullAudioOutput::Write(const MxS16* p_samples, MxU32 p_frames)
+{
+	m_framesWritten += p_frames;
+	return SUCCESS;
+}
+
+MxWaveFileAudioOutput::MxWaveFileAudioOutput(const char* p_path)
+{
+	m_file = fopen(p_path, "wb");
+	m_dataSize = 0;
+}
+
+MxWaveFileAudioOutput::~MxWaveFileAudioOutput()
+{
+	Close();
+}
+
+MxResult MxWaveFileAudioOutput::Open(MxU32 p_sampleRate, MxU16 p_channels)
+{
+	if (m_file == NULL) {
+		return FAILURE;
+	}
+
+	MxNullAudioOutput::Open(p_sampleRate, p_channels);
+
+	// The sizes are not known yet, the header is written again on Close
+	m_dataSize = 0;
+	WriteHeader();
+	return SUCCESS;
+}
+
+void MxWaveFileAudioOutput::Close()
+{
+	if (m_file) {
+		fseek(m_file, 0, SEEK_SET);
+		WriteHeader();
+		fclose(m_file);
+		m_file = NULL;
+	}
+}
+
+MxResult MxWaveFileAudioOutput::Write(const MxS16* p_samples, MxU32 p_frames)
+{
+	MxU32 length = p_frames * m_channels * sizeof(MxS16);
+
+	if (m_file == NULL || fwrite(p_samples, 1, length, m_file) != length) {
+		return FAILURE;
+	}
+
+	m_dataSize += length;
+	return MxNullAudioOutput::Write(p_samples, p_frames);
+}
+
+void MxWaveFileAudioOutput::WriteHeader()
+{
+	MxU16 blockAlign = m_channels * sizeof(MxS16);
+	MxU32 riffSize = 36 + m_dataSize;
+	MxU32 fmtSize = 16;
+	MxU16 formatTag = WAVE_FORMAT_PCM;
+	MxU32 bytesPerSec = m_sampleRate * blockAlign;
+	MxU16 bitsPerSample = 16;
+
+	fwrite("RIFF", 1, 4, m_file);
+	fwrite(&riffSize, sizeof(riffSize), 1, m_file);
+	fwrite("WAVEfmt ", 1, 8, m_file);
+	fwrite(&fmtSize, sizeof(fmtSize), 1, m_file);
+	fwrite(&formatTag, sizeof(formatTag), 1, m_file);
+	fwrite(&m_channels, sizeof(m_channels), 1, m_file);
+	fwrite(&m_sampleRate, sizeof(m_sampleRate), 1, m_file);
+	fwrite(&bytesPerSec, sizeof(bytesPerSec), 1, m_file);
+	fwrite(&blockAlign, sizeof(blockAlign), 1, m_file);
+	fwrite(&bitsPerSample, sizeof(bitsPerSample), 1, m_file);
+	fwrite("data", 1, 4, m_file);
+	fwrite(&m_dataSize, sizeof(m_dataSize), 1, m_file);
+}
@@ -1,5 +1,7 @@
 #include "mxsoundmanager.h"
 
+#include "mxaudiomixer.h"
+#include "mxaudiooutput.h"
 #include "mxautolock.h"
 #include "mxdsaction.h"
 #include "mxmisc.h"
@@ -11,6 +13,9 @@
 
 DECOMP_SIZE_ASSERT(MxSoundManager, 0x3c);
 
+MxAudioOutput* MxSoundManager::g_mixerOutput = NULL;
+MxAudioMixer* MxSoundManager::g_mixer = NULL;
+
 // GLOBAL LEGO1 0x10101420
 MxS32 g_volumeAttenuation[100] = {-6643, -5643, -5058, -4643, -4321, -4058, -3836, -3643, -3473, -3321, -3184, -3058,
 								  -2943, -2836, -2736, -2643, -2556, -2473, -2395, -2321, -2251, -2184, -2120, -2058,
@@ -58,6 +63,11 @@ void MxSoundManager::Destroy(MxBool p_fromDestructor)
 		m_dsBuffer->Release();
 	}
 
+	delete g_mixer;
+	g_mixer = NULL;
+	delete g_mixerOutput;
+	g_mixerOutput = NULL;
+
 	Init();
 	m_criticalSection.Leave();
 
@@ -79,6 +89,19 @@ MxResult MxSoundManager::Create(MxU32 p_frequencyMS, MxBool p_createThread)
 	m_criticalSection.Enter();
 	locked = TRUE;
 
+	if (g_mixerOutput) {
+		g_mixer = new MxAudioMixer;
+		if (g_mixer && g_mixer->Create(g_mixerOutput, 22050, 2, 10) == SUCCESS) {
+			goto createThread;
+		}
+
+		// The output could not be opened, play every sound in its own DirectSound buffer
+		delete g_mixer;
+		g_mixer = NULL;
+		delete g_mixerOutput;
+		g_mixerOutput = NULL;
+	}
+
 	if (DirectSoundCreate(NULL, &m_directSound, NULL) != DS_OK) {
 		goto done;
 	}
@@ -130,6 +153,7 @@ MxResult MxSoundManager::Create(MxU32 p_frequencyMS, MxBool p_createThread)
 
 	status = m_dsBuffer->SetFormat(&format);
 
+createThread:
 	if (p_createThread) {
 		m_thread = new MxTickleThread(this, p_frequencyMS);
 
@@ -207,6 +231,74 @@ MxS32 MxSoundManager::GetAttenuation(MxU32 p_volume)
 	return g_volumeAttenuation[p_volume - 1];
 }
 
+// With an output set before Create, all sounds are played by the software mixer.
+// The sound manager deletes the output when it is destroyed.
+void MxSoundManager::SetMixerOutput(MxAudioOutput* p_output)
+{
+	delete g_mixerOutput;
+	g_mixerOutput = p_output;
+}
+
+// Selects the mixer output by name: "directsound", "null" or the path of a
+// .wav file to record to. An empty name plays through DirectSound buffers.
+MxResult MxSoundManager::SetMixerOutput(const char* p_name)
+{
+	MxU32 length = strlen(p_name);
+
+	if (length == 0) {
+		SetMixerOutput((MxAudioOutput*) NULL);
+	}
+	else if (!strcmpi(p_name, "directsound")) {
+		SetMixerOutput(new MxDirectSoundAudioOutput);
+	}
+	else if (!strcmpi(p_name, "null")) {
+		SetMixerOutput(new MxNullAudioOutput);
+	}
+	else if (length > 4 && !strcmpi(p_name + length - 4, ".wav")) {
+		SetMixerOutput(new MxWaveFileAudioOutput(p_name));
+	}
+	else {
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+// Whether sounds are played in 3D. The mixer has no 3D processing, so while it
+// plays the sounds they are panned instead, regardless of MxOmni's setting.
+MxBool MxSoundManager::IsSound3D()
+{
+	return MxOmni::IsSound3D() && g_mixer == NULL;
+}
+
+// Creates a secondary buffer, or a voice of the software mixer if it is used
+MxResult MxSoundManager::CreateSoundBuffer(LPCDSBUFFERDESC p_desc, LPDIRECTSOUNDBUFFER* p_buffer)
+{
+	if (g_mixer) {
+		return g_mixer->CreateVoice(p_desc, p_buffer);
+	}
+
+	if (m_directSound == NULL || m_directSound->CreateSoundBuffer(p_desc, p_buffer, NULL) != DS_OK) {
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+// Creates a buffer that plays the memory of p_source, without copying it
+MxResult MxSoundManager::DuplicateSoundBuffer(LPDIRECTSOUNDBUFFER p_source, LPDIRECTSOUNDBUFFER* p_buffer)
+{
+	if (g_mixer) {
+		return g_mixer->DuplicateVoice(p_source, p_buffer);
+	}
+
+	if (m_directSound == NULL || m_directSound->DuplicateSoundBuffer(p_source, p_buffer) != DS_OK) {
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
 // FUNCTION: LEGO1 0x100aed10
 void MxSoundManager::Pause()
 {
@@ -5,10 +5,13 @@
 #include "mxomni.h"
 
 #include <assert.h>
+#include <ctype.h>
+#include <string.h>
 
 DECOMP_SIZE_ASSERT(MxAtomId, 0x04);
 DECOMP_SIZE_ASSERT(MxAtom, 0x14);
 DECOMP_SIZE_ASSERT(MxAtomSet, 0x10);
+DECOMP_SIZE_ASSERT(MxAtomIndex, 0x20);
 
 // FUNCTION: LEGO1 0x100acf90
 // FUNCTION: BETA10 0x1012308b
@@ -50,18 +53,31 @@ void MxAtomId::Destroy()
 		return;
 	}
 
+	// Every id holds the key of its atom, so the atom is found by address
+	MxAtom* atom = MxAtomIndex::GetInstance()->FindByKey(m_internal);
+
+	if (atom == NULL && !MxAtomIndex::GetInstance()->IsComplete()) {
 #ifdef COMPAT_MODE
-	MxAtomSet::iterator it;
-	{
-		MxAtom idAtom(m_internal);
-		it = AtomSet()->find(&idAtom);
-	}
+		MxAtomSet::iterator it;
+		{
+			MxAtom idAtom(m_internal);
+			it = AtomSet()->find(&idAtom);
+		}
 #else
-	MxAtomSet::iterator it = AtomSet()->find(&MxAtom(m_internal));
+		MxAtomSet::iterator it = AtomSet()->find(&MxAtom(m_internal));
 #endif
-	assert(it != AtomSet()->end());
 
-	MxAtom* atom = (MxAtom*) (*it);
+		if (it != AtomSet()->end()) {
+			atom = *it;
+		}
+	}
+
+	assert(atom);
+
+	if (atom == NULL) {
+		return;
+	}
+
 	atom->Dec();
 }
 
@@ -87,8 +103,23 @@ MxAtomId& MxAtomId::operator=(const MxAtomId& p_atomId)
 // FUNCTION: BETA10 0x10123378
 MxAtom* MxAtomId::GetAtom(const char* p_str, LookupMode p_mode)
 {
-	MxAtomId unused;
-	MxAtom* atom = new MxAtom(p_str);
+	MxAtomIndex* index = MxAtomIndex::GetInstance();
+	MxAtom* atom = NULL;
+
+	// Copies of an MxAtomId pass the key of an existing atom
+	if (p_mode == e_exact) {
+		atom = index->FindByKey(p_str);
+	}
+
+	if (atom == NULL) {
+		atom = index->Find(p_str, p_mode);
+	}
+
+	if (atom != NULL) {
+		return atom;
+	}
+
+	atom = new MxAtom(p_str);
 	assert(atom);
 
 	switch (p_mode) {
@@ -103,17 +134,19 @@ MxAtom* MxAtomId::GetAtom(const char* p_str, LookupMode p_mode)
 		break;
 	}
 
-	MxAtomSet::iterator it = AtomSet()->find(atom);
-	if (it != AtomSet()->end()) {
-		// Atom already in the set. Delete temp value and return it.
-		delete atom;
-		atom = *it;
-	}
-	else {
-		// Atom is not in the set. Add it.
-		AtomSet()->insert(atom);
+	// Atoms the index could not take are only in the set
+	if (!index->IsComplete()) {
+		MxAtomSet::iterator it = AtomSet()->find(atom);
+
+		if (it != AtomSet()->end()) {
+			delete atom;
+			return *it;
+		}
 	}
 
+	AtomSet()->insert(atom);
+	index->Add(atom);
+
 	return atom;
 }
 
@@ -141,3 +174,195 @@ void MxAtom::Dec()
 		m_value--;
 	}
 }
+
+MxAtomIndex::MxAtomIndex()
+{
+	m_entries = NULL;
+	m_keys = NULL;
+	m_capacity = 0;
+	m_numAtoms = 0;
+	m_complete = TRUE;
+	ResetStatistics();
+}
+
+// The index is never destroyed, since ids may still be destroyed while static
+// objects are torn down
+MxAtomIndex* MxAtomIndex::GetInstance()
+{
+	static MxAtomIndex* g_instance = new MxAtomIndex;
+	return g_instance;
+}
+
+MxAtom* MxAtomIndex::Find(const char* p_str, LookupMode p_mode)
+{
+	m_numLookups++;
+
+	if (m_numAtoms == 0) {
+		return NULL;
+	}
+
+	MxU32 hash = Hash(p_str, p_mode);
+
+	for (MxU32 slot = hash & (m_capacity - 1);; slot = (slot + 1) & (m_capacity - 1)) {
+		Entry& entry = m_entries[slot];
+		m_numProbes++;
+
+		if (entry.m_atom == NULL) {
+			return NULL;
+		}
+
+		if (entry.m_hash == hash && Matches(entry.m_atom->GetKey().GetData(), p_str, p_mode)) {
+			return entry.m_atom;
+		}
+	}
+}
+
+MxAtom* MxAtomIndex::FindByKey(const char* p_key)
+{
+	if (m_numAtoms == 0 || p_key == NULL) {
+		return NULL;
+	}
+
+	for (MxU32 slot = HashKey(p_key) & (m_capacity - 1);; slot = (slot + 1) & (m_capacity - 1)) {
+		MxAtom* atom = m_keys[slot];
+
+		if (atom == NULL) {
+			return NULL;
+		}
+
+		if (atom->GetKey().GetData() == p_key) {
+			m_numKeyHits++;
+			return atom;
+		}
+	}
+}
+
+// The key of the atom must not change afterwards
+MxResult MxAtomIndex::Add(MxAtom* p_atom)
+{
+	// Keep the tables at most half full
+	if ((m_numAtoms + 1) * 2 > m_capacity && Grow() != SUCCESS) {
+		m_complete = FALSE;
+		return FAILURE;
+	}
+
+	Insert(Hash(p_atom->GetKey().GetData(), e_exact), p_atom);
+	m_numAtoms++;
+	return SUCCESS;
+}
+
+void MxAtomIndex::Clear()
+{
+	delete[] m_entries;
+	delete[] m_keys;
+	m_entries = NULL;
+	m_keys = NULL;
+	m_capacity = 0;
+	m_numAtoms = 0;
+	m_complete = TRUE;
+}
+
+// FNV-1a over the key as it is stored for p_mode, that is after strupr or strlwr
+MxU32 MxAtomIndex::Hash(const char* p_str, LookupMode p_mode)
+{
+	MxU32 hash = 2166136261u;
+
+	for (const char* c = p_str; *c != '\0'; c++) {
+		MxU8 value = *c;
+
+		if (p_mode == e_upperCase) {
+			value = toupper(value);
+		}
+		else if (p_mode == e_lowerCase || p_mode == e_lowerCase2) {
+			value = tolower(value);
+		}
+
+		hash = (hash ^ value) * 16777619u;
+	}
+
+	return hash;
+}
+
+MxU32 MxAtomIndex::HashKey(const char* p_key)
+{
+	MxU32 hash = (MxU32) (size_t) p_key * 2654435761u;
+	return hash ^ (hash >> 16);
+}
+
+MxBool MxAtomIndex::Matches(const char* p_key, const char* p_str, LookupMode p_mode)
+{
+	switch (p_mode) {
+	case e_upperCase:
+		for (; *p_str != '\0'; p_key++, p_str++) {
+			if ((MxU8) *p_key != toupper((MxU8) *p_str)) {
+				return FALSE;
+			}
+		}
+		break;
+	case e_lowerCase:
+	case e_lowerCase2:
+		for (; *p_str != '\0'; p_key++, p_str++) {
+			if ((MxU8) *p_key != tolower((MxU8) *p_str)) {
+				return FALSE;
+			}
+		}
+		break;
+	default:
+		return !strcmp(p_key, p_str);
+	}
+
+	return *p_key == '\0';
+}
+
+MxResult MxAtomIndex::Grow()
+{
+	MxU32 capacity = m_capacity ? m_capacity * 2 : 256;
+	Entry* entries = new Entry[capacity];
+	MxAtom** keys = new MxAtom*[capacity];
+
+	if (entries == NULL || keys == NULL) {
+		delete[] entries;
+		delete[] keys;
+		return FAILURE;
+	}
+
+	memset(entries, 0, sizeof(Entry) * capacity);
+	memset(keys, 0, sizeof(MxAtom*) * capacity);
+
+	Entry* oldEntries = m_entries;
+	MxU32 oldCapacity = m_capacity;
+
+	delete[] m_keys;
+	m_entries = entries;
+	m_keys = keys;
+	m_capacity = capacity;
+
+	for (MxU32 i = 0; i < oldCapacity; i++) {
+		if (oldEntries[i].m_atom != NULL) {
+			Insert(oldEntries[i].m_hash, oldEntries[i].m_atom);
+		}
+	}
+
+	delete[] oldEntries;
+	return SUCCESS;
+}
+
+void MxAtomIndex::Insert(MxU32 p_hash, MxAtom* p_atom)
+{
+	MxU32 slot = p_hash & (m_capacity - 1);
+
+	while (m_entries[slot].m_atom != NULL) {
+		slot = (slot + 1) & (m_capacity - 1);
+	}
+
+	m_entries[slot].m_hash = p_hash;
+	m_entries[slot].m_atom = p_atom;
+
+	slot = HashKey(p_atom->GetKey().GetData()) & (m_capacity - 1);
+
+	while (m_keys[slot] != NULL) {
+		slot = (slot + 1) & (m_capacity - 1);
+	}
+
+	m_keys[slot] = p_atom;
+}
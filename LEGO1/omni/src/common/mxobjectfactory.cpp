@@ -16,31 +16,35 @@
 
 DECOMP_SIZE_ASSERT(MxObjectFactory, 0x38); // 100af1db
 
+MxObjectFactoryTable MxObjectFactory::g_table;
+
+// Not part of the original game.
+// The creators registered with g_table.
+#define X(V)                                                                                                           \
+	static MxCore* New##V()                                                                                            \
+	{                                                                                                                  \
+		return new V;                                                                                                  \
+	}
+FOR_MXOBJECTFACTORY_OBJECTS(X)
+#undef X
+
 // FUNCTION: LEGO1 0x100b0d80
 MxObjectFactory::MxObjectFactory()
 {
 #define X(V) m_id##V = MxAtomId(#V, e_exact);
 	FOR_MXOBJECTFACTORY_OBJECTS(X)
 #undef X
+
+#define X(V) g_table.Register(#V, New##V);
+	FOR_MXOBJECTFACTORY_OBJECTS(X)
+#undef X
 }
 
 // FUNCTION: LEGO1 0x100b12c0
 // FUNCTION: BETA10 0x10143177
 MxCore* MxObjectFactory::Create(const char* p_name)
 {
-	MxCore* object = NULL;
-	MxAtomId atom(p_name, e_exact);
-
-	if (0) {
-	}
-#define X(V)                                                                                                           \
-	else if (m_id##V == atom)                                                                                          \
-	{                                                                                                                  \
-		object = new V;                                                                                                \
-	}
-	FOR_MXOBJECTFACTORY_OBJECTS(X)
-#undef X
-	return object;
+	return g_table.Create(p_name);
 }
 
 // FUNCTION: LEGO1 0x100b1a30
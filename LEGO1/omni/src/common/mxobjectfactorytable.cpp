@@ -0,0 +1,82 @@
+#include "mxobjectfactorytable.h"
+
+#include <string.h>
+
+DECOMP_SIZE_ASSERT(MxObjectFactoryTable, 0x1004)
+
+MxObjectFactoryTable::MxObjectFactoryTable()
+{
+	memset(m_entries, 0, sizeof(m_entries));
+	m_numEntries = 0;
+}
+
+void MxObjectFactoryTable::Register(const char* p_name, MxObjectCreator p_creator)
+{
+	MxU32 hash = Hash(p_name);
+	Entry* entry = Find(p_name, hash);
+
+	if (entry == NULL) {
+		return;
+	}
+
+	if (entry->m_name == NULL) {
+		entry->m_name = p_name;
+		entry->m_hash = hash;
+		entry->m_count = 0;
+		m_numEntries++;
+	}
+
+	entry->m_creator = p_creator;
+}
+
+MxCore* MxObjectFactoryTable::Create(const char* p_name)
+{
+	if (p_name == NULL) {
+		return NULL;
+	}
+
+	Entry* entry = Find(p_name, Hash(p_name));
+
+	if (entry == NULL || entry->m_name == NULL) {
+		return NULL;
+	}
+
+	entry->m_count++;
+	return entry->m_creator();
+}
+
+void MxObjectFactoryTable::ResetCounts()
+{
+	for (MxS32 i = 0; i < c_numSlots; i++) {
+		m_entries[i].m_count = 0;
+	}
+}
+
+// FNV-1a
+MxU32 MxObjectFactoryTable::Hash(const char* p_name)
+{
+	MxU32 hash = 2166136261u;
+
+	for (const char* c = p_name; *c != '\0'; c++) {
+		hash = (hash ^ (MxU8) *c) * 16777619u;
+	}
+
+	return hash;
+}
+
+// Returns the entry of the name, or the empty slot it would go into.
+// Returns NULL if the name is not registered and the table is full.
+MxObjectFactoryTable::Entry* MxObjectFactoryTable::Find(const char* p_name, MxU32 p_hash)
+{
+	MxU32 slot = p_hash & (c_numSlots - 1);
+
+	for (MxS32 i = 0; i < c_numSlots; i++, slot = (slot + 1) & (c_numSlots - 1)) {
+		Entry* entry = &m_entries[slot];
+
+		if (entry->m_name == NULL || (entry->m_hash == p_hash && !strcmp(entry->m_name, p_name))) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
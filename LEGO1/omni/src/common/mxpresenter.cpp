@@ -23,6 +23,7 @@
 #include "mxstillpresenter.h"
 #include "mxstreamer.h"
 #include "mxutilities.h"
+#include "mxvideomanager.h"
 #include "mxwavepresenter.h"
 
 #include <string.h>
@@ -49,6 +50,7 @@ MxResult MxPresenter::StartAction(MxStreamController*, MxDSAction* p_action)
 	m_action = p_action;
 	m_location = MxPoint32(m_action->GetLocation()[0], m_action->GetLocation()[1]);
 	m_displayZ = m_action->GetLocation()[2];
+	MxVideoManager::InvalidateLayout();
 
 	ProgressTickleState(e_ready);
 
@@ -1,75 +1,101 @@
 #include "mxstring.h"
 
 #include "decomp.h"
+#include "mxautolock.h"
+#include "mxcriticalsection.h"
 
 #include <stdlib.h>
 #include <string.h>
 
 DECOMP_SIZE_ASSERT(MxString, 0x10)
 
+MxU32 MxString::g_numAllocations = 0;
+
+// Not part of the original game.
+// The blocks of short strings. Freed blocks are linked through their first
+// bytes and reused. The pool is never destroyed, strings may outlive it.
+union MxStringPoolBlock {
+	MxStringPoolBlock* m_next;
+	char m_data[32];
+};
+
+static MxStringPoolBlock* g_stringPoolFree = NULL;
+
+static MxCriticalSection& GetStringPoolLock()
+{
+	static MxCriticalSection* g_lock = new MxCriticalSection;
+	return *g_lock;
+}
+
 // FUNCTION: LEGO1 0x100ae200
 // FUNCTION: BETA10 0x1012c110
 MxString::MxString()
 {
-	// Set string to one char in length and set that char to null terminator
-	this->m_data = new char[1];
-	this->m_data[0] = 0;
-	this->m_length = 0;
+	Init();
 }
 
 // FUNCTION: LEGO1 0x100ae2a0
 // FUNCTION: BETA10 0x1012c1a1
 MxString::MxString(const MxString& p_str)
 {
-	this->m_length = p_str.m_length;
-	this->m_data = new char[this->m_length + 1];
-	strcpy(this->m_data, p_str.m_data);
+	Init();
+	Assign(p_str.m_data, p_str.m_length);
 }
 
 // FUNCTION: LEGO1 0x100ae350
 // FUNCTION: BETA10 0x1012c24f
 MxString::MxString(const char* p_str)
 {
+	Init();
+
 	if (p_str) {
-		this->m_length = strlen(p_str);
-		this->m_data = new char[this->m_length + 1];
-		strcpy(this->m_data, p_str);
-	}
-	else {
-		this->m_data = new char[1];
-		this->m_data[0] = 0;
-		this->m_length = 0;
+		Assign(p_str, strlen(p_str));
 	}
 }
 
 // FUNCTION: BETA10 0x1012c330
 MxString::MxString(const char* p_str, MxU16 p_maxlen)
 {
+	Init();
+
 	if (p_str) {
-		if (strlen(p_str) <= p_maxlen) {
-			this->m_length = strlen(p_str);
-		}
-		else {
-			this->m_length = p_maxlen;
-		}
+		MxU32 length = strlen(p_str);
 
 		// Basically strncpy
-		this->m_data = new char[this->m_length + 1];
-		memcpy(this->m_data, p_str, this->m_length);
-		this->m_data[this->m_length] = '\0';
+		Assign(p_str, length <= p_maxlen ? length : p_maxlen);
 	}
-	else {
-		this->m_data = new char[1];
-		this->m_data[0] = 0;
-		this->m_length = 0;
+}
+
+// Concatenates both strings with a single allocation
+MxString::MxString(const char* p_str1, MxU32 p_length1, const char* p_str2, MxU32 p_length2)
+{
+	Init();
+
+	if (p_length1 > c_maxLength) {
+		p_length1 = c_maxLength;
+	}
+
+	if (p_length2 > c_maxLength - p_length1) {
+		p_length2 = c_maxLength - p_length1;
 	}
+
+	MxU32 length = p_length1 + p_length2;
+
+	if (length > GetCapacity()) {
+		m_data = Allocate(length);
+	}
+
+	memcpy(m_data, p_str1, p_length1);
+	memcpy(m_data + p_length1, p_str2, p_length2);
+	m_data[length] = '\0';
+	m_length = length;
 }
 
 // FUNCTION: LEGO1 0x100ae420
 // FUNCTION: BETA10 0x1012c45b
 MxString::~MxString()
 {
-	delete[] this->m_data;
+	FreeData();
 }
 
 // FUNCTION: BETA10 0x1012c4de
@@ -104,10 +130,7 @@ void MxString::ToLowerCase()
 MxString& MxString::operator=(const MxString& p_str)
 {
 	if (this->m_data != p_str.m_data) {
-		delete[] this->m_data;
-		this->m_length = p_str.m_length;
-		this->m_data = new char[this->m_length + 1];
-		strcpy(this->m_data, p_str.m_data);
+		Assign(p_str.m_data, p_str.m_length);
 	}
 
 	return *this;
@@ -118,10 +141,7 @@ MxString& MxString::operator=(const MxString& p_str)
 const MxString& MxString::operator=(const char* p_str)
 {
 	if (this->m_data != p_str) {
-		delete[] this->m_data;
-		this->m_length = strlen(p_str);
-		this->m_data = new char[this->m_length + 1];
-		strcpy(this->m_data, p_str);
+		Assign(p_str, strlen(p_str));
 	}
 
 	return *this;
@@ -130,16 +150,7 @@ const MxString& MxString::operator=(const char* p_str)
 // FUNCTION: BETA10 0x1012c68a
 MxString MxString::operator+(const MxString& p_str) const
 {
-	MxString tmp;
-	delete[] tmp.m_data;
-
-	tmp.m_length = p_str.m_length + this->m_length;
-	tmp.m_data = new char[tmp.m_length + 1];
-
-	strcpy(tmp.m_data, this->m_data);
-	strcpy(tmp.m_data + this->m_length, p_str.m_data);
-
-	return MxString(tmp);
+	return MxString(this->m_data, this->m_length, p_str.m_data, p_str.m_length);
 }
 
 // Return type is intentionally just MxString, not MxString&.
@@ -148,33 +159,20 @@ MxString MxString::operator+(const MxString& p_str) const
 // FUNCTION: BETA10 0x1012c78d
 MxString MxString::operator+(const char* p_str) const
 {
-	// MxString constructor allocates 1 byte for m_data, so free that first
-	MxString tmp;
-	delete[] tmp.m_data;
-
-	tmp.m_length = strlen(p_str) + this->m_length;
-	tmp.m_data = new char[tmp.m_length + 1];
-
-	strcpy(tmp.m_data, this->m_data);
-	strcpy(tmp.m_data + this->m_length, p_str);
-
-	return MxString(tmp);
+	return MxString(this->m_data, this->m_length, p_str, strlen(p_str));
 }
 
 // FUNCTION: LEGO1 0x100ae690
 // FUNCTION: BETA10 0x1012c92f
 MxString& MxString::operator+=(const char* p_str)
 {
-	int newlen = this->m_length + strlen(p_str);
-
-	char* tmp = new char[newlen + 1];
-	strcpy(tmp, this->m_data);
-	strcpy(tmp + this->m_length, p_str);
-
-	delete[] this->m_data;
-	this->m_data = tmp;
-	this->m_length = newlen;
+	Append(p_str, strlen(p_str));
+	return *this;
+}
 
+MxString& MxString::operator+=(const MxString& p_str)
+{
+	Append(p_str.m_data, p_str.m_length);
 	return *this;
 }
 
@@ -185,3 +183,107 @@ void MxString::CharSwap(char* p_a, char* p_b)
 	*p_a = *p_b;
 	*p_b = t;
 }
+
+// The old data is only freed after copying, p_str may point into it.
+// Lengths are stored in 16 bits, so longer strings are cut off.
+void MxString::Assign(const char* p_str, MxU32 p_length)
+{
+	if (p_length > c_maxLength) {
+		p_length = c_maxLength;
+	}
+
+	if (p_length > GetCapacity()) {
+		char* data = Allocate(p_length);
+		memcpy(data, p_str, p_length);
+		FreeData();
+		m_data = data;
+	}
+	else {
+		memmove(m_data, p_str, p_length);
+	}
+
+	m_data[p_length] = '\0';
+	m_length = p_length;
+}
+
+// Grows the capacity geometrically, so repeated appends are amortized
+void MxString::Append(const char* p_str, MxU32 p_length)
+{
+	if (p_length > c_maxLength - m_length) {
+		p_length = c_maxLength - m_length;
+	}
+
+	MxU32 length = m_length + p_length;
+
+	if (length > GetCapacity()) {
+		MxU32 capacity = GetCapacity() * 2;
+
+		if (capacity < length) {
+			capacity = length;
+		}
+		else if (capacity > c_maxLength) {
+			capacity = c_maxLength;
+		}
+
+		char* data = Allocate(capacity);
+		memcpy(data, m_data, m_length);
+		memcpy(data + m_length, p_str, p_length);
+		FreeData();
+		m_data = data;
+	}
+	else {
+		memmove(m_data + m_length, p_str, p_length);
+	}
+
+	m_data[length] = '\0';
+	m_length = length;
+}
+
+char* MxString::Allocate(MxU16 p_capacity)
+{
+	MxU16* block;
+
+	if (p_capacity <= c_poolCapacity) {
+		AUTOLOCK(GetStringPoolLock());
+
+		if (g_stringPoolFree == NULL) {
+			// Blocks are added a chunk at a time and never returned to the heap
+			const MxU32 count = 64;
+			MxStringPoolBlock* chunk = new MxStringPoolBlock[count];
+			g_numAllocations++;
+
+			for (MxU32 i = 0; i < count; i++) {
+				chunk[i].m_next = g_stringPoolFree;
+				g_stringPoolFree = &chunk[i];
+			}
+		}
+
+		block = (MxU16*) g_stringPoolFree;
+		g_stringPoolFree = g_stringPoolFree->m_next;
+		p_capacity = c_poolCapacity;
+	}
+	else {
+		block = (MxU16*) new char[sizeof(MxU16) + p_capacity + 1];
+		g_numAllocations++;
+	}
+
+	*block = p_capacity;
+	return (char*) (block + 1);
+}
+
+void MxString::FreeData()
+{
+	if (!IsInline()) {
+		char* block = m_data - sizeof(MxU16);
+
+		if (GetCapacity() == c_poolCapacity) {
+			AUTOLOCK(GetStringPoolLock());
+			MxStringPoolBlock* poolBlock = (MxStringPoolBlock*) block;
+			poolBlock->m_next = g_stringPoolFree;
+			g_stringPoolFree = poolBlock;
+		}
+		else {
+			delete[] block;
+		}
+	}
+}
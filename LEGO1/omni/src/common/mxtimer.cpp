@@ -9,12 +9,15 @@ MxLong MxTimer::g_lastTimeCalculated = 0;
 // GLOBAL: LEGO1 0x10101418
 MxLong MxTimer::g_lastTimeTimerStarted = 0;
 
+// The original used the millisecond resolution of timeGetTime
+MxClockProc MxTimer::g_clockProc = MxClock::GetMicroseconds;
+
 // FUNCTION: LEGO1 0x100ae060
 // FUNCTION: BETA10 0x1012bea0
 MxTimer::MxTimer()
 {
 	m_isRunning = FALSE;
-	m_startTime = timeGetTime();
+	m_startTime = GetClockTime();
 	InitLastTimeCalculated();
 }
 
@@ -22,7 +25,7 @@ MxTimer::MxTimer()
 // FUNCTION: BETA10 0x1012bf23
 MxLong MxTimer::GetRealTime()
 {
-	MxTimer::g_lastTimeCalculated = timeGetTime();
+	MxTimer::g_lastTimeCalculated = GetClockTime();
 	return MxTimer::g_lastTimeCalculated - m_startTime;
 }
 
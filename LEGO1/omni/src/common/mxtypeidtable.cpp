@@ -0,0 +1,97 @@
+#include "mxtypeidtable.h"
+
+#include "mxautolock.h"
+
+#include <stddef.h>
+#include <string.h>
+
+DECOMP_SIZE_ASSERT(MxTypeIdTable, 0x2928)
+DECOMP_SIZE_ASSERT(MxTypeId, 0x08)
+
+MxTypeIdTable::MxTypeIdTable()
+{
+	memset(m_typeNames, 0, sizeof(m_typeNames));
+	m_numTypes = 0;
+	memset(m_classes, 0, sizeof(m_classes));
+	ResetStatistics();
+}
+
+// The table is never destroyed, since globals may still query it while static
+// objects are torn down
+MxTypeIdTable* MxTypeIdTable::GetInstance()
+{
+	static MxTypeIdTable* g_instance = new MxTypeIdTable;
+	return g_instance;
+}
+
+MxS32 MxTypeIdTable::GetTypeId(const char* p_name)
+{
+	AUTOLOCK(m_lock);
+
+	for (MxS32 i = 0; i < m_numTypes; i++) {
+		if (!strcmp(m_typeNames[i], p_name)) {
+			return i;
+		}
+	}
+
+	if (m_numTypes == c_maxTypes) {
+		return -1;
+	}
+
+	m_typeNames[m_numTypes] = p_name;
+	return m_numTypes++;
+}
+
+MxBool MxTypeIdTable::IsA(const MxCore* p_object, MxS32 p_typeId)
+{
+	const char* className = p_object->ClassName();
+	ClassEntry* entry = FindClass(className);
+
+	MxU32 word = p_typeId / 32;
+	MxU32 bit = 1 << (p_typeId % 32);
+
+	if (entry != NULL && entry->m_className == className && (entry->m_known[word] & bit)) {
+		m_numHits++;
+		return (entry->m_results[word] & bit) != 0;
+	}
+
+	MxBool result = p_object->IsA(m_typeNames[p_typeId]);
+	m_numMisses++;
+
+	if (entry != NULL) {
+		AUTOLOCK(m_lock);
+
+		// Another class may have taken the slot in the meantime
+		if (entry->m_className == NULL) {
+			entry->m_className = className;
+		}
+		else if (entry->m_className != className) {
+			return result;
+		}
+
+		if (result) {
+			entry->m_results[word] |= bit;
+		}
+
+		entry->m_known[word] |= bit;
+	}
+
+	return result;
+}
+
+// Returns the entry of the class, or the empty slot it would go into.
+// Returns NULL if the class is not in the table and the table is full.
+MxTypeIdTable::ClassEntry* MxTypeIdTable::FindClass(const char* p_className)
+{
+	MxU32 slot = ((MxU32) (size_t) p_className >> 2) & (c_numClassSlots - 1);
+
+	for (MxS32 i = 0; i < c_numClassSlots; i++, slot = (slot + 1) & (c_numClassSlots - 1)) {
+		const char* className = m_classes[slot].m_className;
+
+		if (className == p_className || className == NULL) {
+			return &m_classes[slot];
+		}
+	}
+
+	return NULL;
+}
@@ -217,6 +217,7 @@ void MxOmni::Destroy()
 		}
 
 		delete m_atomSet;
+		MxAtomIndex::GetInstance()->Clear();
 	}
 
 	Init();
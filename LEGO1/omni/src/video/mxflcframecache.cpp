@@ -0,0 +1,104 @@
+#include "mxflcframecache.h"
+
+#include "mxbitmap.h"
+#include "mxstreamchunk.h"
+
+DECOMP_SIZE_ASSERT(MxFlcFrameCache::Frame, 0x20)
+DECOMP_SIZE_ASSERT(MxFlcFrameCache, 0x20)
+
+MxU32 MxFlcFrameCache::g_memoryBudget = 0x800000;
+MxU32 MxFlcFrameCache::g_memoryUsed = 0;
+
+MxFlcFrameCache::MxFlcFrameCache()
+{
+	m_memoryUsed = 0;
+	m_numHits = 0;
+	m_secondsSaved = 0.0;
+}
+
+MxFlcFrameCache::~MxFlcFrameCache()
+{
+	Clear();
+}
+
+void MxFlcFrameCache::Clear()
+{
+	for (FrameMap::iterator it = m_frames.begin(); it != m_frames.end(); it++) {
+		delete[] (*it).second.m_image;
+		delete[] (*it).second.m_palette;
+	}
+
+	m_frames.erase(m_frames.begin(), m_frames.end());
+	g_memoryUsed -= m_memoryUsed;
+	m_memoryUsed = 0;
+}
+
+// Copies the frame decoded from p_chunk into p_bitmap. Returns FALSE if it is not cached.
+MxBool MxFlcFrameCache::Restore(MxStreamChunk* p_chunk, MxBitmap* p_bitmap, MxBool& p_decodedColorMap)
+{
+	FrameMap::iterator it = m_frames.find(p_chunk);
+
+	// The chunk data is compared as well, in case the chunk was freed and its address reused
+	if (it == m_frames.end() || (*it).second.m_chunkData != p_chunk->GetData() ||
+		(*it).second.m_chunkLength != p_chunk->GetLength() || (*it).second.m_imageSize != p_bitmap->GetDataSize()) {
+		return FALSE;
+	}
+
+	Frame& frame = (*it).second;
+	memcpy(p_bitmap->GetImage(), frame.m_image, frame.m_imageSize);
+
+	if (frame.m_palette != NULL) {
+		memcpy(p_bitmap->GetBitmapInfo()->m_bmiColors, frame.m_palette, sizeof(RGBQUAD) * 256);
+	}
+
+	p_decodedColorMap = frame.m_decodedColorMap;
+	m_numHits++;
+	m_secondsSaved += frame.m_decodeSeconds;
+	return TRUE;
+}
+
+void MxFlcFrameCache::Store(MxStreamChunk* p_chunk, MxBitmap* p_bitmap, MxBool p_decodedColorMap, double p_decodeSeconds)
+{
+	// The address of a freed chunk was reused, drop the stale frame
+	FrameMap::iterator it = m_frames.find(p_chunk);
+	if (it != m_frames.end()) {
+		Erase(it);
+	}
+
+	MxU32 size = FrameSize(p_bitmap->GetDataSize(), p_decodedColorMap);
+	if (g_memoryUsed + size > g_memoryBudget) {
+		return;
+	}
+
+	Frame frame;
+	frame.m_chunkData = p_chunk->GetData();
+	frame.m_chunkLength = p_chunk->GetLength();
+	frame.m_imageSize = p_bitmap->GetDataSize();
+	frame.m_image = new MxU8[frame.m_imageSize];
+	frame.m_palette = NULL;
+	frame.m_decodedColorMap = p_decodedColorMap;
+	frame.m_decodeSeconds = p_decodeSeconds;
+
+	memcpy(frame.m_image, p_bitmap->GetImage(), frame.m_imageSize);
+
+	if (p_decodedColorMap) {
+		frame.m_palette = new RGBQUAD[256];
+		memcpy(frame.m_palette, p_bitmap->GetBitmapInfo()->m_bmiColors, sizeof(RGBQUAD) * 256);
+	}
+
+	m_frames[p_chunk] = frame;
+	m_memoryUsed += size;
+	g_memoryUsed += size;
+}
+
+void MxFlcFrameCache::Erase(FrameMap::iterator p_it)
+{
+	MxU32 size = FrameSize((*p_it).second.m_imageSize, (*p_it).second.m_palette != NULL);
+
+	delete[] (*p_it).second.m_image;
+	delete[] (*p_it).second.m_palette;
+	m_frames.erase(p_it);
+
+	m_memoryUsed -= size;
+	g_memoryUsed -= size;
+}
@@ -2,13 +2,56 @@
 
 #include "decomp.h"
 #include "mxbitmap.h"
+#include "mxdebug.h"
+#include "mxdirectx/mxstopwatch.h"
 #include "mxdsmediaaction.h"
+#include "mxflcframecache.h"
 #include "mxmisc.h"
 #include "mxpalette.h"
 #include "mxvideomanager.h"
 
 DECOMP_SIZE_ASSERT(MxFlcPresenter, 0x68);
 
+struct MxFlcFrameCacheCompare {
+	MxBool operator()(MxFlcPresenter* const& p_a, MxFlcPresenter* const& p_b) const { return p_a < p_b; }
+};
+
+// Not part of the original game.
+// The frame caches of the presenters, which have no room for them in their layout.
+map<MxFlcPresenter*, MxFlcFrameCache*, MxFlcFrameCacheCompare> g_flcFrameCaches;
+
+MxFlcFrameCache* FindFlcFrameCache(MxFlcPresenter* p_presenter)
+{
+	map<MxFlcPresenter*, MxFlcFrameCache*, MxFlcFrameCacheCompare>::iterator it = g_flcFrameCaches.find(p_presenter);
+
+	if (it != g_flcFrameCaches.end()) {
+		return (*it).second;
+	}
+
+	MxFlcFrameCache* cache = new MxFlcFrameCache;
+	g_flcFrameCaches[p_presenter] = cache;
+	return cache;
+}
+
+void DestroyFlcFrameCache(MxFlcPresenter* p_presenter)
+{
+	map<MxFlcPresenter*, MxFlcFrameCache*, MxFlcFrameCacheCompare>::iterator it = g_flcFrameCaches.find(p_presenter);
+
+	if (it != g_flcFrameCaches.end()) {
+		MxFlcFrameCache* cache = (*it).second;
+		MxTrace(
+			"MxFlcPresenter %p: %u frames cached, %u hits, %.2f ms of decoding saved\n",
+			p_presenter,
+			cache->GetNumFrames(),
+			cache->GetNumHits(),
+			cache->GetSecondsSaved() * 1000.0
+		);
+
+		delete cache;
+		g_flcFrameCaches.erase(it);
+	}
+}
+
 // FUNCTION: LEGO1 0x100b3310
 MxFlcPresenter::MxFlcPresenter()
 {
@@ -20,11 +63,21 @@ MxFlcPresenter::MxFlcPresenter()
 // FUNCTION: LEGO1 0x100b3420
 MxFlcPresenter::~MxFlcPresenter()
 {
+	DestroyFlcFrameCache(this);
+
 	if (this->m_flcHeader) {
 		delete this->m_flcHeader;
 	}
 }
 
+// The presenter is reused for another action after Destroy, the cached frames
+// would only keep its memory alive until then
+void MxFlcPresenter::Destroy()
+{
+	DestroyFlcFrameCache(this);
+	MxVideoPresenter::Destroy();
+}
+
 // FUNCTION: LEGO1 0x100b3490
 void MxFlcPresenter::LoadHeader(MxStreamChunk* p_chunk)
 {
@@ -41,6 +94,9 @@ void MxFlcPresenter::CreateBitmap()
 
 	m_frameBitmap = new MxBitmap;
 	m_frameBitmap->SetSize(m_flcHeader->width, m_flcHeader->height, NULL, FALSE);
+	MxVideoManager::InvalidateLayout();
+
+	DestroyFlcFrameCache(this);
 }
 
 // FUNCTION: LEGO1 0x100b3570
@@ -56,13 +112,34 @@ void MxFlcPresenter::LoadFrame(MxStreamChunk* p_chunk)
 	data += rectCount * sizeof(MxRect32);
 
 	MxBool decodedColorMap;
-	DecodeFLCFrame(
-		&m_frameBitmap->GetBitmapInfo()->m_bmiHeader,
-		m_frameBitmap->GetImage(),
-		m_flcHeader,
-		(FLIC_FRAME*) data,
-		&decodedColorMap
-	);
+
+	// While repeating, the chunks come from the looping chunk list and are the same on every pass
+	MxFlcFrameCache* cache = m_currentTickleState == e_repeating ? FindFlcFrameCache(this) : NULL;
+
+	if (cache == NULL) {
+		DecodeFLCFrame(
+			&m_frameBitmap->GetBitmapInfo()->m_bmiHeader,
+			m_frameBitmap->GetImage(),
+			m_flcHeader,
+			(FLIC_FRAME*) data,
+			&decodedColorMap
+		);
+	}
+	else if (!cache->Restore(p_chunk, m_frameBitmap, decodedColorMap)) {
+		MxStopWatch stopWatch;
+		stopWatch.Start();
+
+		DecodeFLCFrame(
+			&m_frameBitmap->GetBitmapInfo()->m_bmiHeader,
+			m_frameBitmap->GetImage(),
+			m_flcHeader,
+			(FLIC_FRAME*) data,
+			&decodedColorMap
+		);
+
+		stopWatch.Stop();
+		cache->Store(p_chunk, m_frameBitmap, decodedColorMap, stopWatch.ElapsedSeconds());
+	}
 
 	if (((MxDSMediaAction*) m_action)->GetPaletteManagement() && decodedColorMap) {
 		RealizePalette();
@@ -0,0 +1,242 @@
+#include "mxsmkdecoder.h"
+
+#include "mxautolock.h"
+#include "mxbitmap.h"
+#include "mxsmk.h"
+#include "mxstreamchunk.h"
+
+DECOMP_SIZE_ASSERT(MxSmkDecoderThread, 0x20)
+DECOMP_SIZE_ASSERT(MxSmkDecoder::Frame, 0x30)
+DECOMP_SIZE_ASSERT(MxSmkDecoder, 0xc4)
+
+MxResult MxSmkDecoderThread::Run()
+{
+	if (m_decoder) {
+		m_decoder->DecodeFrames();
+	}
+
+	return MxThread::Run();
+}
+
+MxResult MxSmkDecoderThread::StartWithDecoder(MxSmkDecoder* p_decoder)
+{
+	m_decoder = p_decoder;
+	return Start(0x1000, 0);
+}
+
+MxSmkDecoder::MxSmkDecoder()
+{
+	m_mxSmk = NULL;
+	m_decodeBitmap = NULL;
+	m_head = 0;
+	m_count = 0;
+	m_numDecoded = 0;
+	m_running = FALSE;
+
+	for (MxS32 i = 0; i < c_numFrames; i++) {
+		m_frames[i].m_chunk = NULL;
+		m_frames[i].m_time = 0;
+		m_frames[i].m_data = NULL;
+		m_frames[i].m_dataSize = 0;
+		m_frames[i].m_paletteChanged = FALSE;
+		m_frames[i].m_bitmap = NULL;
+		m_frames[i].m_rects.SetOwnership(TRUE);
+	}
+}
+
+MxSmkDecoder::~MxSmkDecoder()
+{
+	Destroy();
+}
+
+// The decoder takes over the Smacker state. p_frameBitmap must already be sized
+// for the stream, the decoded frames are copies of it.
+MxResult MxSmkDecoder::Create(MxSmk* p_mxSmk, MxBitmap* p_frameBitmap)
+{
+	MxResult result = FAILURE;
+	MxLong width = p_frameBitmap->GetBmiWidth();
+	MxLong height = p_frameBitmap->GetBmiHeightAbs();
+
+	m_mxSmk = p_mxSmk;
+
+	m_decodeBitmap = new MxBitmap;
+	if (!m_decodeBitmap || m_decodeBitmap->ImportBitmap(p_frameBitmap) != SUCCESS) {
+		goto done;
+	}
+
+	for (MxS32 i = 0; i < c_numFrames; i++) {
+		m_frames[i].m_bitmap = new MxBitmap;
+
+		if (!m_frames[i].m_bitmap || m_frames[i].m_bitmap->SetSize(width, height, NULL, FALSE) != SUCCESS) {
+			goto done;
+		}
+	}
+
+	if (m_workSemaphore.Init(0, 100) != SUCCESS || m_doneSemaphore.Init(0, 100) != SUCCESS) {
+		goto done;
+	}
+
+	m_running = TRUE;
+
+	if (m_thread.StartWithDecoder(this) != SUCCESS) {
+		m_running = FALSE;
+		goto done;
+	}
+
+	result = SUCCESS;
+
+done:
+	if (result != SUCCESS) {
+		Destroy();
+	}
+
+	return result;
+}
+
+void MxSmkDecoder::Destroy()
+{
+	if (m_running) {
+		m_running = FALSE;
+		m_workSemaphore.Release(1);
+		m_thread.Terminate();
+	}
+
+	for (MxS32 i = 0; i < c_numFrames; i++) {
+		delete[] m_frames[i].m_data;
+		m_frames[i].m_data = NULL;
+		m_frames[i].m_dataSize = 0;
+
+		delete m_frames[i].m_bitmap;
+		m_frames[i].m_bitmap = NULL;
+
+		m_frames[i].m_rects.DeleteAll();
+	}
+
+	delete m_decodeBitmap;
+	m_decodeBitmap = NULL;
+
+	m_mxSmk = NULL;
+	m_head = 0;
+	m_count = 0;
+	m_numDecoded = 0;
+}
+
+// The chunk data is copied, so the chunk may be freed before its frame is decoded
+MxResult MxSmkDecoder::Submit(MxStreamChunk* p_chunk, MxBool p_paletteChanged)
+{
+	AUTOLOCK(m_lock);
+
+	if (IsFull()) {
+		return FAILURE;
+	}
+
+	Frame& frame = m_frames[(m_head + m_count) % c_numFrames];
+
+	if (frame.m_dataSize < p_chunk->GetLength()) {
+		delete[] frame.m_data;
+		frame.m_dataSize = p_chunk->GetLength();
+		frame.m_data = new MxU8[frame.m_dataSize];
+	}
+
+	memcpy(frame.m_data, p_chunk->GetData(), p_chunk->GetLength());
+	frame.m_chunk = p_chunk;
+	frame.m_time = p_chunk->GetTime();
+	frame.m_paletteChanged = p_paletteChanged;
+	m_count++;
+
+	m_workSemaphore.Release(1);
+	return SUCCESS;
+}
+
+// Waits until the frame submitted for p_chunk is decoded and returns its index.
+// Frames are presented in the order they were submitted, so only the oldest
+// frame can match. Returns -1 if it does not.
+MxS32 MxSmkDecoder::Acquire(MxStreamChunk* p_chunk)
+{
+	m_lock.Enter();
+
+	if (m_count == 0 || m_frames[m_head].m_chunk != p_chunk || m_frames[m_head].m_time != p_chunk->GetTime()) {
+		m_lock.Leave();
+		return -1;
+	}
+
+	while (m_numDecoded == 0) {
+		m_lock.Leave();
+		m_doneSemaphore.Wait(INFINITE);
+		m_lock.Enter();
+	}
+
+	MxS32 index = m_head;
+	m_lock.Leave();
+	return index;
+}
+
+void MxSmkDecoder::Release(MxS32 p_index)
+{
+	AUTOLOCK(m_lock);
+
+	m_frames[p_index].m_chunk = NULL;
+	m_frames[p_index].m_rects.DeleteAll();
+
+	m_head = (m_head + 1) % c_numFrames;
+	m_count--;
+	m_numDecoded--;
+}
+
+// Waits until every submitted frame is decoded. Afterwards the Smacker state
+// is not touched by the worker until the next submission.
+void MxSmkDecoder::WaitIdle()
+{
+	m_lock.Enter();
+
+	while (m_numDecoded < m_count) {
+		m_lock.Leave();
+		m_doneSemaphore.Wait(INFINITE);
+		m_lock.Enter();
+	}
+
+	m_lock.Leave();
+}
+
+void MxSmkDecoder::DecodeFrames()
+{
+	while (m_running) {
+		m_workSemaphore.Wait(INFINITE);
+
+		if (m_running) {
+			DecodeNextFrame();
+		}
+	}
+}
+
+void MxSmkDecoder::DecodeNextFrame()
+{
+	m_lock.Enter();
+
+	if (m_numDecoded == m_count) {
+		m_lock.Leave();
+		return;
+	}
+
+	Frame& frame = m_frames[(m_head + m_numDecoded) % c_numFrames];
+	m_lock.Leave();
+
+	// The decode bitmap keeps the previous frame, which the delta frames are applied to
+	MxSmk::LoadFrame(
+		m_decodeBitmap->GetBitmapInfo(),
+		m_decodeBitmap->GetImage(),
+		m_mxSmk,
+		frame.m_data,
+		frame.m_paletteChanged,
+		&frame.m_rects
+	);
+
+	memcpy(frame.m_bitmap->GetBitmapInfo(), m_decodeBitmap->GetBitmapInfo(), sizeof(MxBITMAPINFO));
+	memcpy(frame.m_bitmap->GetImage(), m_decodeBitmap->GetImage(), m_decodeBitmap->GetDataSize());
+
+	m_lock.Enter();
+	m_numDecoded++;
+	m_lock.Leave();
+
+	m_doneSemaphore.Release(1);
+}
@@ -2,12 +2,43 @@
 
 #include "decomp.h"
 #include "mxdsmediaaction.h"
+#include "mxdssubscriber.h"
 #include "mxmisc.h"
 #include "mxpalette.h"
+#include "mxsmkdecoder.h"
+#include "mxstl/stlcompat.h"
 #include "mxvideomanager.h"
 
+#include <assert.h>
+
 DECOMP_SIZE_ASSERT(MxSmkPresenter, 0x720);
 
+MxBool MxSmkPresenter::g_decodeInBackground = FALSE;
+
+struct MxSmkDecoderCompare {
+	MxBool operator()(MxSmkPresenter* const& p_a, MxSmkPresenter* const& p_b) const { return p_a < p_b; }
+};
+
+// Not part of the original game.
+// The background decoders of the presenters, which have no room for them in their layout.
+map<MxSmkPresenter*, MxSmkDecoder*, MxSmkDecoderCompare> g_smkDecoders;
+
+MxSmkDecoder* FindSmkDecoder(MxSmkPresenter* p_presenter)
+{
+	map<MxSmkPresenter*, MxSmkDecoder*, MxSmkDecoderCompare>::iterator it = g_smkDecoders.find(p_presenter);
+	return it != g_smkDecoders.end() ? (*it).second : NULL;
+}
+
+void DestroySmkDecoder(MxSmkPresenter* p_presenter)
+{
+	map<MxSmkPresenter*, MxSmkDecoder*, MxSmkDecoderCompare>::iterator it = g_smkDecoders.find(p_presenter);
+
+	if (it != g_smkDecoders.end()) {
+		delete (*it).second;
+		g_smkDecoders.erase(it);
+	}
+}
+
 // FUNCTION: LEGO1 0x100b3650
 MxSmkPresenter::MxSmkPresenter()
 {
@@ -34,6 +65,7 @@ void MxSmkPresenter::Destroy(MxBool p_fromDestructor)
 {
 	m_criticalSection.Enter();
 
+	DestroySmkDecoder(this);
 	MxSmk::Destroy(&m_mxSmk);
 	Init();
 
@@ -59,11 +91,31 @@ void MxSmkPresenter::CreateBitmap()
 
 	m_frameBitmap = new MxBitmap;
 	m_frameBitmap->SetSize(m_mxSmk.m_smackTag.Width, m_mxSmk.m_smackTag.Height, NULL, FALSE);
+	MxVideoManager::InvalidateLayout();
+
+	DestroySmkDecoder(this);
+
+	if (g_decodeInBackground) {
+		MxSmkDecoder* decoder = new MxSmkDecoder;
+
+		if (decoder->Create(&m_mxSmk, m_frameBitmap) == SUCCESS) {
+			g_smkDecoders[this] = decoder;
+		}
+		else {
+			delete decoder;
+		}
+	}
 }
 
 // FUNCTION: LEGO1 0x100b3a00
 void MxSmkPresenter::LoadFrame(MxStreamChunk* p_chunk)
 {
+	MxSmkDecoder* decoder = FindSmkDecoder(this);
+	if (decoder != NULL) {
+		LoadDecodedFrame(decoder, p_chunk);
+		return;
+	}
+
 	MxBITMAPINFO* bitmapInfo = m_frameBitmap->GetBitmapInfo();
 	MxU8* bitmapData = m_frameBitmap->GetImage();
 	MxU8* chunkData = p_chunk->GetData();
@@ -90,6 +142,72 @@ void MxSmkPresenter::LoadFrame(MxStreamChunk* p_chunk)
 	}
 }
 
+// Advances the frame counter the same way LoadFrame does and queues the chunk
+// on the decoder. The decoder has to be idle, because VTable0x88 may reset the
+// palette of the Smacker state it decodes with.
+void MxSmkPresenter::SubmitFrame(MxSmkDecoder* p_decoder, MxStreamChunk* p_chunk)
+{
+	p_decoder->WaitIdle();
+
+	MxBool paletteChanged = m_mxSmk.m_frameTypes[m_currentFrame] & 1;
+	m_currentFrame++;
+	VTable0x88();
+
+	p_decoder->Submit(p_chunk, paletteChanged);
+}
+
+void MxSmkPresenter::LoadDecodedFrame(MxSmkDecoder* p_decoder, MxStreamChunk* p_chunk)
+{
+	MxS32 index = p_decoder->Acquire(p_chunk);
+
+	// The chunk was not decoded ahead, e.g. a chunk replayed while repeating.
+	// Only the chunk that is popped next is ever decoded ahead, so nothing else
+	// is pending. A pending frame could not be dropped, since submitting it has
+	// already advanced the frame counter and the Smacker state.
+	if (index < 0) {
+		assert(p_decoder->IsEmpty());
+		SubmitFrame(p_decoder, p_chunk);
+		index = p_decoder->Acquire(p_chunk);
+
+		if (index < 0) {
+			return;
+		}
+	}
+
+	MxSmkDecoder::Frame& frame = p_decoder->GetFrame(index);
+	MxBitmap* bitmap = m_frameBitmap;
+	m_frameBitmap = frame.m_bitmap;
+	frame.m_bitmap = bitmap;
+
+	if (((MxDSMediaAction*) m_action)->GetPaletteManagement() && frame.m_paletteChanged) {
+		RealizePalette();
+	}
+
+	MxRect32 invalidateRect;
+	MxRectListCursor cursor(&frame.m_rects);
+	MxRect32* rect;
+
+	while (cursor.Next(rect)) {
+		invalidateRect = *rect;
+		invalidateRect.AddPoint(GetLocation());
+		MVideoManager()->InvalidateRect(invalidateRect);
+	}
+
+	p_decoder->Release(index);
+
+	// Decode the next chunk while this frame is on screen. While streaming, the
+	// chunk at the head of the subscriber is the one LoadFrame gets next.
+	if (m_currentTickleState != e_streaming || m_subscriber == NULL) {
+		return;
+	}
+
+	MxStreamChunk* next = m_subscriber->PeekData();
+
+	if (next != NULL && !(next->GetChunkFlags() & (DS_CHUNK_END_OF_STREAM | DS_CHUNK_BIT3)) && p_decoder->IsEmpty()) {
+		SubmitFrame(p_decoder, next);
+	}
+}
+
 // FUNCTION: LEGO1 0x100b4260
 void MxSmkPresenter::VTable0x88()
 {
@@ -127,3 +245,9 @@ void MxSmkPresenter::Destroy()
 {
 	Destroy(FALSE);
 }
+
+// Presenters created afterwards decode their frames on a worker thread
+void MxSmkPresenter::SetDecodeInBackground(MxBool p_decodeInBackground)
+{
+	g_decodeInBackground = p_decodeInBackground;
+}
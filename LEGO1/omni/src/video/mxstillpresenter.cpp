@@ -55,6 +55,8 @@ void MxStillPresenter::CreateBitmap()
 
 	delete m_bitmapInfo;
 	m_bitmapInfo = NULL;
+
+	MxVideoManager::InvalidateLayout();
 }
 
 // FUNCTION: LEGO1 0x100b9db0
@@ -94,6 +96,8 @@ void MxStillPresenter::LoadFrame(MxStreamChunk* p_chunk)
 		delete m_frameBitmap;
 		m_frameBitmap = NULL;
 
+		MxVideoManager::InvalidateLayout();
+
 		if (m_unk0x58 && und) {
 			SetBit2(TRUE);
 		}
@@ -154,6 +158,7 @@ void MxStillPresenter::SetPosition(MxS32 p_x, MxS32 p_y)
 	MxS32 y = m_location.GetY();
 	m_location.SetX(p_x);
 	m_location.SetY(p_y);
+	MxVideoManager::InvalidateLayout();
 
 	if (IsEnabled()) {
 		// Most likely needs to work with MxSize32 and MxPoint32
@@ -255,6 +260,8 @@ MxStillPresenter* MxStillPresenter::Clone()
 					presenter->m_alpha = new MxVideoPresenter::AlphaMask(*m_alpha);
 				}
 
+				MxVideoManager::InvalidateLayout();
+
 				result = SUCCESS;
 			}
 		}
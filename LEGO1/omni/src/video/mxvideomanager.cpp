@@ -12,6 +12,8 @@
 
 DECOMP_SIZE_ASSERT(MxVideoManager, 0x64)
 
+MxU32 MxVideoManager::g_layoutVersion = 0;
+
 // FUNCTION: LEGO1 0x100be1f0
 MxVideoManager::MxVideoManager()
 {
@@ -123,6 +125,7 @@ void MxVideoManager::SortPresenterList()
 					a.SetValue(presenterB);
 					b.SetValue(presenterA);
 					finished = FALSE;
+					InvalidateLayout();
 				}
 			}
 		} while (!finished && --count != 0);
@@ -146,6 +146,8 @@ void MxVideoPresenter::Destroy(MxBool p_fromDestructor)
 		MVideoManager()->UnregisterPresenter(*this);
 	}
 
+	MxVideoManager::InvalidateLayout();
+
 	if (m_unk0x58) {
 		m_unk0x58->Release();
 		m_unk0x58 = NULL;
@@ -538,6 +540,7 @@ MxResult MxVideoPresenter::AddToManager()
 	if (MVideoManager()) {
 		result = SUCCESS;
 		MVideoManager()->RegisterPresenter(*this);
+		MxVideoManager::InvalidateLayout();
 	}
 
 	return result;
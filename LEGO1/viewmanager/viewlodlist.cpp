@@ -18,7 +18,14 @@ int ViewLODListManager::g_ROINameUID = 0;
 // FUNCTION: BETA10 0x10178310
 inline void ViewLODList::Dump(void (*pTracer)(const char*, ...)) const
 {
-	pTracer("   ViewLODList<0x%x>: Capacity=%d, Size=%d, RefCount=%d\n", this, Capacity(), Size(), m_refCount);
+	pTracer(
+		"   ViewLODList<0x%x>: Capacity=%d, Size=%d, RefCount=%d, MemorySize=%d\n",
+		this,
+		Capacity(),
+		Size(),
+		m_refCount,
+		GetMemorySize()
+	);
 
 	for (int i = 0; i < (int) Size(); i++) {
 		ViewLOD* lod = const_cast<ViewLOD*>(this->operator[](i));
@@ -150,3 +157,46 @@ unsigned char ViewLODListManager::Destroy(ViewLODList* lodList)
 
 	return deleted;
 }
+
+// Estimates the size of the vertex and index buffers of all LODs in the list.
+// A vertex is counted as a D3DRMVERTEX, a face as three indices.
+size_t ViewLODList::GetMemorySize() const
+{
+	size_t size = 0;
+
+	for (int i = 0; i < (int) Size(); i++) {
+		const ViewLOD* lod = this->operator[](i);
+		size += lod->NVerts() * (8 * sizeof(float) + sizeof(unsigned long)) + lod->NumPolys() * 3 * sizeof(unsigned);
+	}
+
+	return size;
+}
+
+const char* ViewLODListManager::GetName(const ViewLODList* lodList) const
+{
+	ViewLODListMap::const_iterator iterator;
+
+	for (iterator = m_map.begin(); !(iterator == m_map.end()); ++iterator) {
+		if ((*iterator).second == lodList) {
+			return (*iterator).first;
+		}
+	}
+
+	return NULL;
+}
+
+void ViewLODListManager::GetMemoryStatistics(size_t& p_size, size_t& p_unsharedSize) const
+{
+	ViewLODListMap::const_iterator iterator;
+
+	p_size = 0;
+	p_unsharedSize = 0;
+
+	for (iterator = m_map.begin(); !(iterator == m_map.end()); ++iterator) {
+		const ViewLODList* pLODList = (*iterator).second;
+		size_t size = pLODList->GetMemorySize();
+
+		p_size += size;
+		p_unsharedSize += size * pLODList->GetRefCount();
+	}
+}
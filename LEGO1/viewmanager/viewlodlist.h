@@ -40,6 +40,10 @@ class ViewLODList : public LODList<ViewLOD> {
 	inline int AddRef();
 	inline int Release();
 
+	// Not part of the original game
+	int GetRefCount() const { return m_refCount; }
+	size_t GetMemorySize() const;
+
 #ifdef _DEBUG
 	void Dump(void (*pTracer)(const char*, ...)) const;
 #endif
@@ -94,6 +98,14 @@ class ViewLODListManager {
 	ViewLODList* Lookup(const ROIName&) const;
 	unsigned char Destroy(ViewLODList* lodList);
 
+	// Not part of the original game.
+	// returns the name a ViewLODList is stored under, or NULL
+	const char* GetName(const ViewLODList* lodList) const;
+
+	// sums the geometry of all ViewLODLists, once as stored and once as
+	// if every reference held its own copy
+	void GetMemoryStatistics(size_t& p_size, size_t& p_unsharedSize) const;
+
 #ifdef _DEBUG
 	void Dump(void (*pTracer)(const char*, ...)) const;
 #endif